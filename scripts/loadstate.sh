@@ -2,17 +2,23 @@
 
 hc() { "${herbstclient_command[@]:-herbstclient}" "$@" ;}
 
-# loads layouts for each tag coming from stdin
-# the format is the one created by savestate.sh
+# restores the session coming from stdin
+# the format is the one created by savestate.sh. Files written by older
+# versions of savestate.sh, with one 'TAG: LAYOUT' line per tag, are
+# loaded as well.
 
 # a common usage is:
 # savestate.sh > mystate
 # and sometime later:
 # loadstate.sh < mystate
 
-while read line ; do
-    tag="${line%%: *}"
-    tree="${line#*: }"
-    hc add "$tag"
-    hc load "$tag" "$tree"
-done
+state="$(cat)"
+first_entry="$(grep -v -e '^#' -e '^$' <<< "$state" | head -n 1)"
+case "$first_entry" in
+    tag$'\t'*|client$'\t'*|monitor$'\t'*|attr$'\t'*)
+        hc load_session "$state"
+        ;;
+    *)
+        hc load_layouts "$state"
+        ;;
+esac
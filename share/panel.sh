@@ -62,6 +62,8 @@ else
 fi
 
 hc pad $monitor $panel_height
+# let herbstluftwm push the tag status whenever it changes
+hc set tag_status_hook on
 
 {
     ### Event generator ###
@@ -142,9 +144,10 @@ hc pad $monitor $panel_height
         IFS=$'\t' read -ra cmd || break
         # find out event origin
         case "${cmd[0]}" in
-            tag*)
-                #echo "resetting tags" >&2
-                IFS=$'\t' read -ra tags <<< "$(hc tag_status $monitor)"
+            tag_status)
+                if [ "${cmd[1]}" = "$monitor" ] ; then
+                    tags=( "${cmd[@]:2}" )
+                fi
                 ;;
             date)
                 #echo "resetting date" >&2
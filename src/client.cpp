@@ -1,11 +1,13 @@
 #include "client.h"
 
+#include <X11/Xatom.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
 
+#include "clientedgeindex.h"
 #include "clientmanager.h"
 #include "decoration.h"
 #include "ewmh.h"
@@ -60,8 +62,8 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     , ewmhnotify_(this, "ewmhnotify", true)
     , sizehints_floating_(this, "sizehints_floating", true)
     , sizehints_tiling_(this, "sizehints_tiling", false)
-    , window_class_(this, "class", &Client::getWindowClass)
-    , window_instance_(this, "instance", &Client::getWindowInstance)
+    , window_class_(this, "class", &Client::windowClass)
+    , window_instance_(this, "instance", &Client::windowInstance)
     , content_geometry_(this, "content_geometry", {})
     , decoration_geometry_(this, "decoration_geometry", &Client::decorationGeometry)
     , manager(cm)
@@ -105,8 +107,13 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     minimized_.changed().connect([this]() {
         static long long minimizedTick = 0;
         minimizedLastChange_ = minimizedTick++;
+        updateTagMembership(flagsTag_ != nullptr);
         this->updateEwmhState();
     });
+    urgent_.changed().connect([this]() {
+        // a client that is not counted anymore stays uncounted
+        updateTagMembership(flagsTag_ != nullptr);
+    });
 
     float_size_.setWritable();
     float_size_.changedByUser().connect(this, &Client::floatingGeometryChanged);
@@ -223,10 +230,46 @@ void Client::listen_for_events() {
 }
 
 void Client::setTag(HSTag *tag) {
+    if (tag_) {
+        tag_->edgeIndex->remove(this);
+    }
     tag_ = tag;
+    if (tag_) {
+        tag_->edgeIndex->update(this, dec->last_outer());
+    }
+    updateTagMembership();
     ewmh.windowUpdateTag(window_, tag);
 }
 
+void Client::updateTagMembership(bool counted)
+{
+    HSTag* tag = counted ? tag_ : nullptr;
+    bool urgent = urgent_();
+    bool minimized = minimized_();
+    if (tag == flagsTag_ && urgent == flagsUrgent_
+        && minimized == flagsMinimized_
+        && (!minimized || minimizedLastChange_ == flagsMinimizedTick_))
+    {
+        return;
+    }
+    if (flagsTag_) {
+        flagsTag_->countClientFlags(flagsUrgent_, -1);
+        if (flagsMinimized_) {
+            flagsTag_->minimizedClients_.erase(flagsMinimizedTick_);
+        }
+    }
+    if (tag) {
+        tag->countClientFlags(urgent, 1);
+        if (minimized) {
+            tag->minimizedClients_[minimizedLastChange_] = this;
+        }
+    }
+    flagsTag_ = tag;
+    flagsUrgent_ = urgent;
+    flagsMinimized_ = minimized;
+    flagsMinimizedTick_ = minimizedLastChange_;
+}
+
 bool Client::ignore_unmapnotify() {
     if (ignore_unmaps_ > 0) {
         ignore_unmaps_--;
@@ -246,6 +289,10 @@ Client* get_client_from_window(Window window) {
 
 // destroys a special client
 Client::~Client() {
+    updateTagMembership(false);
+    if (tag_) {
+        tag_->edgeIndex->remove(this);
+    }
     if (lastfocus == this) {
         lastfocus = nullptr;
     }
@@ -571,6 +618,13 @@ void Client::resize_floating(Monitor* m, bool isFocused) {
     if (!m) {
         return;
     }
+    Rectangle rect = floatingGeometryOnMonitor(m);
+    dec->resize_inner(rect, theme[Theme::Type::Floating](isFocused,urgent_()));
+    mostRecentThemeType = Theme::Type::Floating;
+}
+
+//! the (global) geometry of the client's content when floating on the given monitor
+Rectangle Client::floatingGeometryOnMonitor(Monitor* m) {
     Rectangle rect = this->float_size_;
     rect.x += m->rect->x;
     rect.y += m->rect->y;
@@ -586,8 +640,7 @@ void Client::resize_floating(Monitor* m, bool isFocused) {
         CLAMP(rect.y,
               m->rect->y + m->pad_up() - rect.height + space,
               m->rect->y + m->rect->height - m->pad_up() - m->pad_down() - space);
-    dec->resize_inner(rect, theme[Theme::Type::Floating](isFocused,urgent_()));
-    mostRecentThemeType = Theme::Type::Floating;
+    return rect;
 }
 
 Rectangle Client::outer_floating_rect() {
@@ -676,7 +729,7 @@ void Client::set_urgent_force(bool state) {
     XFree(wmh);
     ewmh.updateWindowState(this);
     // report changes to tags
-    tag_set_flags_dirty();
+    tag_update_flags();
 }
 
 // heavily inspired by dwm.c
@@ -698,7 +751,7 @@ void Client::update_wm_hints() {
             this->urgent_ = newval;
             this->setup_border(focused_client == this);
             hook_emit({"urgent", urgent_() ? "on":"off", WindowID(window_).str()});
-            tag_set_flags_dirty();
+            tag_update_flags();
         }
     }
     if (wmh->flags & InputHint) {
@@ -757,6 +810,10 @@ void Client::fixParentWindow(bool decorated)
     }
     // the unmap triggers an unmap notify for the window itself
     ignore_unmaps_++;
+    if (tag()) {
+        // a different window of this client is stacked now
+        tag()->stack->markDirty();
+    }
     needsRelayout.emit(this->tag());
 }
 
@@ -765,14 +822,50 @@ Rectangle Client::decorationGeometry()
     return dec->last_outer();
 }
 
-string Client::getWindowClass()
+string Client::windowClass() const
+{
+    if (!classHint_.has_value()) {
+        classHint_ = X_.getClassHint(window_);
+    }
+    return classHint_->second;
+}
+
+string Client::windowInstance() const
+{
+    if (!classHint_.has_value()) {
+        classHint_ = X_.getClassHint(window_);
+    }
+    return classHint_->first;
+}
+
+int Client::windowType() const
 {
-    return ewmh.X().getClass(window_);
+    if (!windowType_.has_value()) {
+        windowType_ = ewmh.getWindowType(window_);
+    }
+    return windowType_.value();
 }
 
-string Client::getWindowInstance()
+std::experimental::optional<string> Client::windowRole() const
 {
-    return ewmh.X().getInstance(window_);
+    if (!windowRole_.has_value()) {
+        windowRole_ = X_.getWindowProperty(window_, X_.atom("WM_WINDOW_ROLE"));
+    }
+    return windowRole_.value();
+}
+
+void Client::propertyChanged(Atom property)
+{
+    if (property == XA_WM_CLASS) {
+        classHint_ = {};
+    } else if (property == ewmh.netatom(NetWmWindowType)) {
+        windowType_ = {};
+    } else if (property == X_.atom("WM_WINDOW_ROLE")) {
+        windowRole_ = {};
+    } else if (property == X_.atom("_NET_WM_PID")) {
+        pid_ = X_.windowPid(window_);
+        pgid_ = X_.windowPgid(window_);
+    }
 }
 
 FrameLeaf* Client::parentFrame()
@@ -3,12 +3,15 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <string>
+#include <utility>
 
 #include "attribute_.h"
 #include "child.h"
 #include "commandio.h"
 #include "converter.h"
 #include "object.h"
+#include "optional.h"
 #include "rectangle.h"
 #include "regexstr.h"
 #include "theme.h"
@@ -113,6 +116,7 @@ public:
     void setup_border(bool focused);
     void resize_tiling(Rectangle rect, bool isFocused, bool minimalDecoration, std::vector<Client*> tabs);
     void resize_floating(Monitor* m, bool isFocused);
+    Rectangle floatingGeometryOnMonitor(Monitor* m);
     void resize_fullscreen(Rectangle m, bool isFocused);
     bool is_client_floated();
     void set_urgent(bool state);
@@ -135,14 +139,25 @@ public:
     bool ignore_unmapnotify();
 
     void updateEwmhState();
+    //! update the client counters of the tags, which define the tag flags,
+    //! and the index of minimized clients of the tags.
+    //! If not counted, the client is not considered for any tag.
+    void updateTagMembership(bool counted = true);
+
+    // properties of the client window. They are only fetched from the
+    // X server again after they have been changed by the client.
+    std::string windowClass() const;
+    std::string windowInstance() const;
+    int windowType() const;
+    std::experimental::optional<std::string> windowRole() const;
+    //! forget the cached value of a property after a PropertyNotify event
+    void propertyChanged(Atom property);
 private:
     void floatingGeometryChanged();
     void fixParentWindow(bool decorated);
     void redraw();
     void redrawRelevantTabBars();
     Rectangle decorationGeometry();
-    std::string getWindowClass();
-    std::string getWindowInstance();
     std::string triggerRelayoutMonitor();
     FrameLeaf* parentFrame();
     void requestRedraw();
@@ -156,6 +171,17 @@ private:
     const DecTriple& getDecTriple();
     const DecorationScheme& getDecorationScheme(bool focused);
     Theme::Type mostRecentThemeType;
+    //! the tag and urgency state this client is counted for in the tag flags
+    HSTag* flagsTag_ = nullptr;
+    bool flagsUrgent_ = false;
+    //! whether and under which key the client is in the minimized index
+    bool flagsMinimized_ = false;
+    long long int flagsMinimizedTick_ = 0;
+    // the property cache, an empty optional means that the value
+    // has to be fetched again
+    mutable std::experimental::optional<std::pair<std::string, std::string>> classHint_;
+    mutable std::experimental::optional<int> windowType_;
+    mutable std::experimental::optional<std::experimental::optional<std::string>> windowRole_;
 };
 
 
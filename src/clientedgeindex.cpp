@@ -0,0 +1,128 @@
+#include "clientedgeindex.h"
+
+#include <climits>
+
+using std::make_pair;
+using std::swap;
+
+ClientEdgeIndex::Key ClientEdgeIndex::centerKey(Direction dir)
+{
+    switch (dir) {
+        case Direction::Right: return Key::CenterRight;
+        case Direction::Left: return Key::CenterLeft;
+        case Direction::Up: return Key::CenterUp;
+        case Direction::Down: return Key::CenterDown;
+    }
+    return Key::CenterRight;
+}
+
+Rectangle ClientEdgeIndex::rotated(Rectangle rect, Direction dir)
+{
+    // Note: For Direction::Right, there is nothing to do.
+    if (dir == Direction::Up) {
+        // flip by the horizontal axis, then direction up
+        // has become direction down
+        rect.y = - rect.y - rect.height;
+    }
+    if (dir == Direction::Up || dir == Direction::Down) {
+        // flip by the diagonal
+        //
+        //   *-------------> x     *-------------> x
+        //   |   +------+          |   +---+[]
+        //   |   |      |     ==>  |   |   |
+        //   |   +------+          |   |   |
+        //   |   []                |   +---+
+        //   V                     V
+        swap(rect.x, rect.y);
+        swap(rect.width, rect.height);
+    }
+    if (dir == Direction::Left) {
+        // flip by the vertical axis
+        rect.x = - rect.x - rect.width;
+    }
+    return rect;
+}
+
+int ClientEdgeIndex::keyOf(Rectangle rect, Key key)
+{
+    switch (key) {
+        case Key::Left: return rect.x;
+        case Key::Right: return rect.x + rect.width;
+        case Key::Top: return rect.y;
+        case Key::Bottom: return rect.y + rect.height;
+        default: break;
+    }
+    Direction dir = Direction::Right;
+    switch (key) {
+        case Key::CenterLeft: dir = Direction::Left; break;
+        case Key::CenterUp: dir = Direction::Up; break;
+        case Key::CenterDown: dir = Direction::Down; break;
+        default: break;
+    }
+    Rectangle r = rotated(rect, dir);
+    return r.x + r.width / 2;
+}
+
+void ClientEdgeIndex::update(Client* client, Rectangle geometry)
+{
+    auto it = geometries_.find(client);
+    if (it != geometries_.end()) {
+        if (it->second == geometry) {
+            return;
+        }
+        remove(client);
+    }
+    geometries_[client] = geometry;
+    for (size_t i = 0; i < keyCount; i++) {
+        lists_[i].insert(make_pair(keyOf(geometry, static_cast<Key>(i)), client));
+    }
+}
+
+void ClientEdgeIndex::remove(Client* client)
+{
+    auto it = geometries_.find(client);
+    if (it == geometries_.end()) {
+        return;
+    }
+    for (size_t i = 0; i < keyCount; i++) {
+        lists_[i].erase(make_pair(keyOf(it->second, static_cast<Key>(i)), client));
+    }
+    geometries_.erase(it);
+}
+
+void ClientEdgeIndex::foreachFrom(Key key, int from, LoopBody loopBody) const
+{
+    const SortedList& list = lists_[static_cast<size_t>(key)];
+    for (auto it = list.lower_bound(make_pair(from, nullptr));
+         it != list.end(); it++)
+    {
+        if (!loopBody(it->second, geometries_.at(it->second))) {
+            return;
+        }
+    }
+}
+
+void ClientEdgeIndex::foreachDownFrom(Key key, int from, LoopBody loopBody) const
+{
+    const SortedList& list = lists_[static_cast<size_t>(key)];
+    // the first element with a key greater than 'from'
+    auto it = (from == INT_MAX)
+              ? list.end()
+              : list.lower_bound(make_pair(from + 1, nullptr));
+    while (it != list.begin()) {
+        it--;
+        if (!loopBody(it->second, geometries_.at(it->second))) {
+            return;
+        }
+    }
+}
+
+void ClientEdgeIndex::foreachBetween(Key key, int low, int high, LoopBody loopBody) const
+{
+    foreachFrom(key, low, [&](Client* client, Rectangle geometry) {
+        if (keyOf(geometry, key) > high) {
+            return false;
+        }
+        return loopBody(client, geometry);
+    });
+}
@@ -0,0 +1,68 @@
+#ifndef __HERBST_CLIENTEDGEINDEX_H_
+#define __HERBST_CLIENTEDGEINDEX_H_
+
+#include <array>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "converter.h"
+#include "rectangle.h"
+
+class Client;
+
+/**
+ * @brief The ClientEdgeIndex holds the outer geometries of the clients
+ * of a tag in lists sorted by their edges and centers. It is updated
+ * whenever a client's geometry changes, and so queries for neighbouring
+ * windows only visit the clients close to the given coordinate.
+ */
+class ClientEdgeIndex {
+public:
+    //! the sort keys of the client geometries
+    enum class Key {
+        Left,   //!< the left edge
+        Right,  //!< the right edge
+        Top,    //!< the top edge
+        Bottom, //!< the bottom edge
+        // the x coordinate of the center after rotating the
+        // geometry such that the direction becomes 'right',
+        // see rotated()
+        CenterRight,
+        CenterLeft,
+        CenterUp,
+        CenterDown,
+    };
+    static constexpr size_t keyCount = 8;
+
+    //! the key of the center in the given direction
+    static Key centerKey(Direction dir);
+    //! rotate the rectangle such that 'dir' becomes the direction right
+    static Rectangle rotated(Rectangle rect, Direction dir);
+    static int keyOf(Rectangle rect, Key key);
+
+    //! insert the client or update its geometry
+    void update(Client* client, Rectangle geometry);
+    void remove(Client* client);
+    size_t size() const { return geometries_.size(); }
+
+    using LoopBody = std::function<bool(Client*, Rectangle)>;
+    /** call the loopBody for every client whose key is at least 'from'
+     * in ascending order of the key, until the loopBody returns false
+     */
+    void foreachFrom(Key key, int from, LoopBody loopBody) const;
+    /** call the loopBody for every client whose key is at most 'from'
+     * in descending order of the key, until the loopBody returns false
+     */
+    void foreachDownFrom(Key key, int from, LoopBody loopBody) const;
+    //! call the loopBody for every client whose key is in [low, high]
+    void foreachBetween(Key key, int low, int high, LoopBody loopBody) const;
+
+private:
+    using SortedList = std::set<std::pair<int, Client*>>;
+    std::unordered_map<Client*, Rectangle> geometries_;
+    std::array<SortedList, keyCount> lists_;
+};
+
+#endif
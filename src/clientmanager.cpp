@@ -87,7 +87,7 @@ Client* ClientManager::client(Window window)
  *          no such client, throw an exception.
  *
  * \param   str     Describes the window: "" means the focused one, "urgent"
- *                  resolves to a arbitrary urgent window, "0x..." just
+ *                  resolves to the most recently urgent window, "0x..." just
  *                  resolves to the given window given its hexadecimal window id,
  *                  a decimal number its decimal window id.
  * \return          Pointer to the resolved client.
@@ -103,10 +103,8 @@ Client* ClientManager::parse(const string& identifier)
         }
     }
     if (identifier == "urgent") {
-        for (auto c : clients_) {
-            if (c.second->urgent_) {
-                return c.second;
-            }
+        if (!urgentClients_.empty()) {
+            return *urgentClients_.begin();
         }
         throw std::invalid_argument("No client is urgent");
     }
@@ -162,6 +160,16 @@ void ClientManager::add(Client* client)
     client->minimized_.changed().connect([this,client]() {
         this->clientStateChanged.emit(client);
     });
+    if (client->urgent_()) {
+        urgentClients_.insert(client);
+    }
+    client->urgent_.changed().connect([this,client]() {
+        if (client->urgent_()) {
+            this->urgentClients_.insert(client);
+        } else {
+            this->urgentClients_.remove(client);
+        }
+    });
     addChild(client, client->window_id_str);
     clientAdded.emit(client);
 }
@@ -178,7 +186,9 @@ void ClientManager::setDragged(Client* client) {
 
 void ClientManager::remove(Window window)
 {
-    removeChild(*clients_[window]->window_id_str);
+    Client* client = clients_[window];
+    urgentClients_.remove(client);
+    removeChild(*client->window_id_str);
     clients_.erase(window);
 }
 
@@ -248,7 +258,7 @@ Client* ClientManager::manage_client(Window win, bool visible_already, bool forc
     // insert window to the tag
     client->tag()->insertClient(client, changes.tree_index, changes.focus);
 
-    tag_set_flags_dirty();
+    tag_update_flags();
     if (changes.fullscreen.has_value()) {
         client->fullscreen_ = changes.fullscreen.value();
     } else {
@@ -566,7 +576,8 @@ void ClientManager::force_unmanage(Client* client) {
     // and arrange monitor after the client has been removed from the stack
     needsRelayout.emit(tag);
     ewmh->removeClient(client->window_);
-    tag_set_flags_dirty();
+    client->updateTagMembership(false);
+    tag_update_flags();
     // delete client
     this->remove(client->window_);
     if (client == focus()) {
@@ -7,6 +7,7 @@
 #include "commandio.h"
 #include "link.h"
 #include "object.h"
+#include "plainstack.h"
 #include "runtimeconverter.h"
 #include "signal.h"
 
@@ -80,6 +81,8 @@ protected:
     Ewmh* ewmh;
     XConnection* X_;
     std::unordered_map<Window, Client*> clients_;
+    //! the urgent clients, the most recently urgent first
+    PlainStack<Client*> urgentClients_;
     friend class Client;
 };
 
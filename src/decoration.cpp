@@ -9,10 +9,12 @@
 #include <vector>
 
 #include "client.h"
+#include "clientedgeindex.h"
 #include "ewmh.h"
 #include "font.h"
 #include "fontdata.h"
 #include "settings.h"
+#include "tag.h"
 #include "theme.h"
 #include "xconnection.h"
 
@@ -110,6 +112,9 @@ void Decoration::createWindow() {
     dec->last_actual_rect = dec->last_inner_rect;
     dec->last_actual_rect.x -= dec->last_outer_rect.x;
     dec->last_actual_rect.y -= dec->last_outer_rect.y;
+    if (client_->tag()) {
+        client_->tag()->edgeIndex->update(client_, dec->last_outer_rect);
+    }
     decwin2client[decwin] = client_;
 
     XSetWindowAttributes resizeAttr;
@@ -349,7 +354,17 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     // update structs
     bool size_changed = outline.width != last_outer_rect.width
                      || outline.height != last_outer_rect.height;
+    // while the client is dragged, only redraw if the look of
+    // the decoration changes. When it is only moved, its
+    // pixmap and the resize areas remain the same.
+    bool redraw_needed = !client_->dragged_
+                     || size_changed
+                     || last_scheme != &scheme
+                     || tabs_ != tabs;
     last_outer_rect = outline;
+    if (client_->tag()) {
+        client_->tag()->edgeIndex->update(client_, last_outer_rect);
+    }
     last_rect_inner = false;
     tabs_ = tabs;
     client_->last_size_ = inner;
@@ -363,13 +378,16 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
         last_actual_rect.height = changes.height;
     }
     XConnection& xcon = xconnection();
-    if (decorated) {
+    if (decorated && redraw_needed) {
+        redrawDeferred_ = false;
         redrawPixmap();
         XSetWindowBackgroundPixmap(xcon.display(), decwin, pixmap);
         if (!size_changed) {
             // if size changes, then the window is cleared automatically
             XClearWindow(xcon.display(), decwin);
         }
+    }
+    if (decorated) {
         if (!client_->dragged_ || settings_.update_dragged_clients()) {
             XConfigureWindow(xcon.display(), win, mask, &changes);
             XMoveResizeWindow(xcon.display(), bgwin,
@@ -381,7 +399,7 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
         XConfigureWindow(xcon.display(), win, mask, &changes);
     }
     // update geometry of resizeArea window
-    if (decorated) {
+    if (decorated && redraw_needed) {
         int bw = 0;
         if (last_scheme) {
             bw = last_scheme->border_width();
@@ -393,6 +411,8 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
                               areaGeo.x, areaGeo.y,
                               areaGeo.width, areaGeo.height);
         }
+    }
+    if (decorated) {
         XMoveResizeWindow(xcon.display(), decwin,
                           outline.x, outline.y, outline.width, outline.height);
     }
@@ -436,6 +456,13 @@ void Decoration::change_scheme(const DecorationScheme& scheme) {
 
 void Decoration::redraw()
 {
+    HSTag* tag = client_->tag();
+    if (tag && !tag->visible()) {
+        // nobody can see the decoration, so postpone
+        // the redraw until the tag is shown again.
+        redrawDeferred_ = true;
+        return;
+    }
     if (client_->decorated_()) {
         if (last_scheme) {
             change_scheme(*last_scheme);
@@ -443,6 +470,14 @@ void Decoration::redraw()
     }
 }
 
+void Decoration::redrawIfDeferred()
+{
+    if (redrawDeferred_) {
+        redrawDeferred_ = false;
+        redraw();
+    }
+}
+
 unsigned long Decoration::get_client_color(Color color) {
     XConnection& xcon = xconnection();
     XColor xcol = color.toXColor();
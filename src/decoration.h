@@ -53,6 +53,8 @@ public:
     void resize_inner(Rectangle inner, const DecorationScheme& scheme);
     void change_scheme(const DecorationScheme& scheme);
     void redraw();
+    //! perform a redraw that was skipped while the client was invisible
+    void redrawIfDeferred();
 
     static Client* toClient(Window decoration_window);
 
@@ -86,6 +88,7 @@ private:
     Rectangle   last_actual_rect = {0, 0, 0, 0}; // last actual client rect, relative to decoration
     std::vector<Client*>    tabs_ = {}; //! the tabs shown in the decoration
     std::vector<ClickArea>  buttons_ = {};
+    bool                    redrawDeferred_ = false; //! redraw() skipped on invisible tag
     /* X specific things */
     Visual*                 visual = nullptr;
     Colormap                colormap = 0;
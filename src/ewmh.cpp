@@ -70,6 +70,7 @@ const std::array<const char*,NetCOUNT> Ewmh::netatomNames_ =
 
 Ewmh::Ewmh(XConnection& xconnection)
     : X_(xconnection)
+    , publisher_(xconnection)
 {
     /* init ewmh net atoms */
     for (int i = 0; i < NetCOUNT; i++) {
@@ -251,18 +252,20 @@ void Ewmh::updateAll() {
 }
 
 Ewmh::~Ewmh() {
+    // publish what was changed during shutdown
+    publisher_.flush();
     XDeleteProperty(X_.display(), X_.root(), netatom_[NetSupportingWmCheck]);
     XDestroyWindow(X_.display(), windowManagerWindow_);
 }
 
 void Ewmh::updateWmName() {
     string name = root_->settings->wmname();
-    X_.setPropertyString(windowManagerWindow_, netatom_[NetWmName], name);
-    X_.setPropertyString(X_.root(), netatom_[NetWmName], name);
+    publisher_.setString(windowManagerWindow_, netatom_[NetWmName], name);
+    publisher_.setString(X_.root(), netatom_[NetWmName], name);
 }
 
 void Ewmh::updateClientList() {
-    X_.setPropertyWindow(X_.root(), netatom_[NetClientList], netClientList_);
+    publisher_.setWindow(X_.root(), netatom_[NetClientList], netClientList_);
 }
 
 const Ewmh::InitialState &Ewmh::initialState()
@@ -271,8 +274,23 @@ const Ewmh::InitialState &Ewmh::initialState()
 }
 
 void Ewmh::updateClientListStacking() {
+    // the stacking order often changes multiple times while handling a
+    // single event, so only recompute and publish it in flush()
+    clientListStackingDirty_ = true;
+}
+
+void Ewmh::flush() {
+    if (clientListStackingDirty_) {
+        clientListStackingDirty_ = false;
+        publishClientListStacking();
+    }
+    publisher_.flush();
+}
+
+void Ewmh::publishClientListStacking() {
     // First: get the windows currently visible
     vector<Window> buf;
+    buf.reserve(netClientList_.size());
     auto addToVector = [&buf](Window w) { buf.push_back(w); };
     root_->monitors->extractWindowStack(true, addToVector);
 
@@ -288,7 +306,7 @@ void Ewmh::updateClientListStacking() {
     // reverse stacking order, because ewmh requires bottom to top order
     std::reverse(buf.begin(), buf.end());
 
-    X_.setPropertyWindow(X_.root(), netatom_[NetClientListStacking], buf);
+    publisher_.setWindow(X_.root(), netatom_[NetClientListStacking], buf);
 }
 
 void Ewmh::addClient(Window win) {
@@ -304,7 +322,7 @@ void Ewmh::removeClient(Window win) {
 }
 
 void Ewmh::updateDesktops() {
-    X_.setPropertyCardinal(X_.root(), netatom_[NetNumberOfDesktops],
+    publisher_.setCardinal(X_.root(), netatom_[NetNumberOfDesktops],
                            { (long) root_->tags->size() });
 }
 
@@ -313,7 +331,7 @@ void Ewmh::updateDesktopNames() {
     for (auto tag : *tags_) {
         names.push_back(tag->name);
     }
-    X_.setPropertyString(X_.root(), netatom_[NetDesktopNames], names);
+    publisher_.setStringList(X_.root(), netatom_[NetDesktopNames], names);
 }
 
 void Ewmh::updateCurrentDesktop() {
@@ -323,7 +341,7 @@ void Ewmh::updateCurrentDesktop() {
         HSWarning("tag %s not found in internal list\n", tag->name->c_str());
         return;
     }
-    X_.setPropertyCardinal(X_.root(), netatom_[NetCurrentDesktop], { index });
+    publisher_.setCardinal(X_.root(), netatom_[NetCurrentDesktop], { index });
 }
 
 void Ewmh::windowUpdateTag(Window win, HSTag* tag) {
@@ -331,11 +349,11 @@ void Ewmh::windowUpdateTag(Window win, HSTag* tag) {
         return;
     }
     int index = tag->index();
-    X_.setPropertyCardinal(win, netatom_[NetWmDesktop], { index });
+    publisher_.setCardinal(win, netatom_[NetWmDesktop], { index });
 }
 
 void Ewmh::updateActiveWindow(Window win) {
-    X_.setPropertyWindow(X_.root(), netatom_[NetActiveWindow], { win });
+    publisher_.setWindow(X_.root(), netatom_[NetActiveWindow], { win });
 }
 
 bool Ewmh::focusStealingAllowed(long source) {
@@ -513,18 +531,15 @@ void Ewmh::updateWindowState(Client* client) {
     };
 
     /* find out which flags are set */
-    Atom window_state[LENGTH(client_atoms)];
-    size_t count_enabled = 0;
+    vector<Atom> window_state;
     for (size_t i = 0; i < LENGTH(client_atoms); i++) {
         if (client_atoms[i].enabled) {
-            window_state[count_enabled] = netatom_[client_atoms[i].atom_index];
-            count_enabled++;
+            window_state.push_back(netatom_[client_atoms[i].atom_index]);
         }
     }
 
     /* write it to the window */
-    XChangeProperty(X_.display(), client->window_, netatom_[NetWmState], XA_ATOM,
-        32, PropModeReplace, (unsigned char *) window_state, count_enabled);
+    publisher_.setAtom(client->window_, netatom_[NetWmState], window_state);
 }
 
 /**
@@ -534,11 +549,11 @@ void Ewmh::updateWindowState(Client* client) {
 void Ewmh::updateFloatingState(Client* client)
 {
     if (client->is_client_floated()) {
-        X_.setPropertyCardinal(client->window_, hlwmFloatingWindow_, {1});
-        X_.deleteProperty(client->window_, hlwmTilingWindow_);
+        publisher_.setCardinal(client->window_, hlwmFloatingWindow_, {1});
+        publisher_.deleteProperty(client->window_, hlwmTilingWindow_);
     } else {
-        X_.deleteProperty(client->window_, hlwmFloatingWindow_);
-        X_.setPropertyCardinal(client->window_, hlwmTilingWindow_, {1});
+        publisher_.deleteProperty(client->window_, hlwmFloatingWindow_);
+        publisher_.setCardinal(client->window_, hlwmTilingWindow_, {1});
     }
 }
 
@@ -546,6 +561,8 @@ void Ewmh::clearClientProperties(Window win) {
     // delete ewmh-properties and ICCCM-Properties such that the client knows
     // that he has been unmanaged and now the client is allowed to be mapped
     // again (e.g. if it is some dialog)
+    // The window is not managed anymore, so do not publish anything else
+    publisher_.forgetWindow(win);
     XDeleteProperty(X_.display(), win, netatom_[NetWmState]);
     XDeleteProperty(X_.display(), win, wmatom(WM::State));
 }
@@ -576,7 +593,7 @@ void Ewmh::setWindowOpacity(Window win, double opacity) {
 }
 
 void Ewmh::updateFrameExtents(Window win, int left, int right, int top, int bottom) {
-    X_.setPropertyCardinal(win, netatom_[NetFrameExtents],
+    publisher_.setCardinal(win, netatom_[NetFrameExtents],
                            { left, right, top, bottom });
 }
 
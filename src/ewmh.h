@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+#include "propertypublisher.h"
+
 /* actions on NetWmState */
 #define _NET_WM_STATE_REMOVE        0    /* remove/unset property */
 #define _NET_WM_STATE_ADD           1    /* add/set property */
@@ -136,6 +138,8 @@ public:
     // ================================================
 
     void updateAll();
+    //! publish the properties whose update was postponed
+    void flush();
 
     void addClient(Window win);
     void removeClient(Window win);
@@ -175,6 +179,7 @@ public:
     void windowClose(Window window);
 
     XConnection& X() { return X_; }
+    PropertyPublisher& publisher() { return publisher_; }
     Atom netatom(int netatomEnum);
     const char* netatomName(int netatomEnum);
 
@@ -192,6 +197,10 @@ private:
 
     //! array with Window-IDs in initial mapping order for _NET_CLIENT_LIST
     std::vector<Window> netClientList_;
+    PropertyPublisher publisher_;
+    //! whether _NET_CLIENT_LIST_STACKING needs to be recomputed
+    bool clientListStackingDirty_ = false;
+    void publishClientListStacking();
     //! window that shows that the WM is still alive
     Window      windowManagerWindow_;
 
@@ -4,9 +4,12 @@
 #include <climits>
 #include <cstdlib>
 #include <limits>
+#include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "client.h"
+#include "clientedgeindex.h"
 #include "decoration.h"
 #include "layout.h"
 #include "monitor.h"
@@ -22,41 +25,11 @@ using std::make_pair;
 // becomes the direction "right". idx is some distinguished element, whose
 // index may change
 static void rectlist_rotate(RectangleIdxVec& rects, int& idx, Direction dir) {
-    // Note: For DirRight, there is nothing to do.
-
-    if (dir == Direction::Up) {
-        // just flip by the horizontal axis
-        for (auto& r : rects) {
-            r.second.y = - r.second.y - r.second.height;
-        }
-        // and flip order to reverse the order for rectangles with the same
-        // center
-        reverse(rects.begin(), rects.end());
-        idx = rects.size() - 1 - idx;
-        // and then direction up now has become direction down
+    for (auto& r : rects) {
+        r.second = ClientEdgeIndex::rotated(r.second, dir);
     }
-
-    if (dir == Direction::Up || dir == Direction::Down) {
-        // flip by the diagonal
-        //
-        //   *-------------> x     *-------------> x
-        //   |   +------+          |   +---+[]
-        //   |   |      |     ==>  |   |   |
-        //   |   +------+          |   |   |
-        //   |   []                |   +---+
-        //   V                     V
-        for (auto& r : rects) {
-            SWAP(int, r.second.x, r.second.y);
-            SWAP(int, r.second.height, r.second.width);
-        }
-    }
-
-    if (dir == Direction::Left) {
-        // flip by the vertical axis
-        for (auto& r : rects) {
-            r.second.x = - r.second.x - r.second.width;
-        }
-        // and flip order to reverse the order for rectangles with the same
+    if (dir == Direction::Up || dir == Direction::Left) {
+        // flip order to reverse the order for rectangles with the same
         // center
         reverse(rects.begin(), rects.end());
         idx = rects.size() - 1 - idx;
@@ -217,59 +190,159 @@ int Floating::find_edge_right_of(RectangleIdxVec rects, int idx) {
 bool Floating::focusDirection(Direction dir) {
     if (g_settings->monitors_locked()) { return false; }
     HSTag* tag = get_current_monitor()->tag;
-    vector<Client*> clients;
-    RectangleIdxVec rects;
-    int idx = 0;
-    int curfocusidx = -1;
     Client* curfocus = get_current_client();
-    tag->foreachClient([&](Client* c) {
-        if (!c->visible_()) {
-            return;
-        }
-        clients.push_back(c);
-        rects.push_back(make_pair(idx,c->dec->last_outer()));
-        if (c == curfocus) {
-            curfocusidx = idx;
-        }
-        idx++;
-    });
-    if (curfocusidx < 0 || idx <= 0) {
+    if (!curfocus || curfocus->tag() != tag || !curfocus->visible_()) {
         return false;
     }
-    idx = find_rectangle_in_direction(rects, curfocusidx, dir);
-    if (idx < 0) {
+    Client* found = find_client_in_direction(tag, curfocus, dir);
+    if (!found) {
         return false;
     }
-    focus_client(clients[idx], false, false, true);
+    focus_client(found, false, false, true);
     return true;
 }
 
+//! find the client that find_rectangle_in_direction() would find for the
+//! visible clients on the tag, but only visit the clients whose center
+//! is close enough to the center of 'curfocus'
+Client* Floating::find_client_in_direction(HSTag* tag, Client* curfocus, Direction dir) {
+    const ClientEdgeIndex& index = *tag->edgeIndex;
+    // all computations happen in the rotated coordinates, where
+    // 'dir' is the direction right
+    auto RC = ClientEdgeIndex::rotated(curfocus->dec->last_outer(), dir);
+    int cx = RC.x + RC.width / 2;
+    int cy = RC.y + RC.height / 2;
+    // the candidates with their manhatten distance to RC. A candidate
+    // with distance 0 has the same center as RC, and so it depends on
+    // the client order whether it is considered at all.
+    vector<pair<int, Client*>> candidates;
+    // the smallest positive distance so far
+    int distbest = INT_MAX;
+    index.foreachFrom(ClientEdgeIndex::centerKey(dir), cx,
+                      [&](Client* c, Rectangle geometry) {
+        auto R2 = ClientEdgeIndex::rotated(geometry, dir);
+        int rcx = R2.x + R2.width / 2 - cx;
+        int rcy = R2.y + R2.height / 2 - cy;
+        if (rcx > distbest) {
+            // the manhatten distance of this and all
+            // remaining clients is at least rcx
+            return false;
+        }
+        if (c == curfocus || !c->visible_() || !rectangle_is_right_of(RC, R2)) {
+            return true;
+        }
+        int dist = abs(rcx) + abs(rcy);
+        if (dist <= distbest) {
+            if (dist > 0) {
+                distbest = dist;
+            }
+            candidates.push_back(make_pair(dist, c));
+        }
+        return true;
+    });
+    // drop candidates that were superseded later
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [distbest](const pair<int, Client*>& p) {
+                                        return p.first != 0 && p.first != distbest;
+                                    }),
+                     candidates.end());
+    if (candidates.empty()) {
+        return nullptr;
+    }
+    if (candidates.size() == 1 && candidates[0].first > 0) {
+        return candidates[0].second;
+    }
+    // otherwise, ties are resolved by the client order, as in
+    // find_rectangle_right_of()
+    std::unordered_map<Client*, int> clientIndex;
+    int count = 0;
+    tag->foreachClient([&](Client* c) {
+        if (c->visible_()) {
+            clientIndex[c] = count++;
+        }
+    });
+    auto rotatedIndex = [&](Client* c) {
+        int i = clientIndex.at(c);
+        // the order is reversed by rectlist_rotate()
+        return (dir == Direction::Up || dir == Direction::Left) ? count - 1 - i : i;
+    };
+    if (clientIndex.find(curfocus) == clientIndex.end()) {
+        return nullptr;
+    }
+    int focusIndex = rotatedIndex(curfocus);
+    Client* best = nullptr;
+    pair<int, int> bestKey = { INT_MAX, INT_MAX };
+    for (const auto& candidate : candidates) {
+        if (clientIndex.find(candidate.second) == clientIndex.end()) {
+            continue;
+        }
+        int i = rotatedIndex(candidate.second);
+        // if two rectangles have exactly the same geometry,
+        // then only consider the later ones
+        if (candidate.first == 0 && i < focusIndex) {
+            continue;
+        }
+        auto key = make_pair(candidate.first, i);
+        if (key < bestKey) {
+            bestKey = key;
+            best = candidate.second;
+        }
+    }
+    return best;
+}
+
 //! when moving the given client on tag in the specified direction
 //! report the vector to travel until the collision happens. If curfocusrect
 //! is provided, use this as the geometry of 'curfocus'
 Point2D Floating::find_rectangle_collision_on_tag(HSTag* tag, Client* curfocus, Direction dir, Rectangle curfocusrect) {
-    vector<Client*> clients;
     auto focusrect = curfocusrect
                 ? curfocusrect
                 : curfocus->dec->last_outer();
-    RectangleIdxVec rects;
-    int idx = 0;
-    int curfocusidx = -1;
-    tag->foreachClient([&](Client* c) {
-        if (!c->visible_()) {
-            return;
+    if (curfocus->tag() != tag || !curfocus->visible_()) {
+        return {0, 0};
+    }
+    int gap = g_settings->snap_gap();
+    // find the next client in the direction: it has to be beyond the
+    // edge of the focus rectangle and the rectangles have to overlap
+    // in the other axis (after expanding by the snap gap).
+    Client* nearest = nullptr;
+    auto findNearest = [&](Client* c, Rectangle r) {
+        if (c == curfocus || !c->visible_()) {
+            return true;
         }
-        clients.push_back(c);
-        if (c == curfocus) {
-            rects.push_back(make_pair(idx,focusrect));
-            curfocusidx = idx;
-        } else {
-            rects.push_back(make_pair(idx,c->dec->last_outer()));
+        bool overlaps = (dir == Direction::Left || dir == Direction::Right)
+            ? intervals_intersect(focusrect.y, focusrect.y + focusrect.height,
+                                  r.y - gap, r.y + r.height + gap)
+            : intervals_intersect(focusrect.x, focusrect.x + focusrect.width,
+                                  r.x - gap, r.x + r.width + gap);
+        if (!overlaps) {
+            return true;
         }
-        idx++;
-    });
-    if (curfocusidx < 0 || idx <= 0) {
-        return {0, 0};
+        nearest = c;
+        return false;
+    };
+    const ClientEdgeIndex& index = *tag->edgeIndex;
+    using Key = ClientEdgeIndex::Key;
+    switch (dir) {
+        case Direction::Right:
+            index.foreachFrom(Key::Left, focusrect.x + focusrect.width + gap + 1, findNearest);
+            break;
+        case Direction::Left:
+            index.foreachDownFrom(Key::Right, focusrect.x - gap - 1, findNearest);
+            break;
+        case Direction::Down:
+            index.foreachFrom(Key::Top, focusrect.y + focusrect.height + gap + 1, findNearest);
+            break;
+        case Direction::Up:
+            index.foreachDownFrom(Key::Bottom, focusrect.y - gap - 1, findNearest);
+            break;
+    }
+    // among the clients, only the nearest one can be hit first
+    RectangleIdxVec rects;
+    int curfocusidx = 0;
+    rects.push_back(make_pair(curfocusidx, focusrect));
+    if (nearest) {
+        rects.push_back(make_pair(1, nearest->dec->last_outer()));
     }
     // add artifical rects for screen edges
     {
@@ -291,12 +364,12 @@ Point2D Floating::find_rectangle_collision_on_tag(HSTag* tag, Client* curfocus,
             continue;
         }
         // expand anything by the snap gap
-        r.second.x -= g_settings->snap_gap();
-        r.second.y -= g_settings->snap_gap();
-        r.second.width += 2 * g_settings->snap_gap();
-        r.second.height += 2 * g_settings->snap_gap();
+        r.second.x -= gap;
+        r.second.y -= gap;
+        r.second.width += 2 * gap;
+        r.second.height += 2 * gap;
     }
-    idx = find_edge_in_direction(rects, curfocusidx, dir);
+    int idx = find_edge_in_direction(rects, curfocusidx, dir);
     if (idx < 0) {
         return {0, 0};
     }
@@ -434,6 +507,167 @@ bool Floating::resizeDirection(HSTag* tag, Client* client, Direction dir)
     return shrink_into_direction(client, dir);
 }
 
+/**
+ * @brief A summed-area table for a list of rectangles. For any given
+ * rectangle, it tells in constant time the sum of the areas of its
+ * intersections with all the rectangles.
+ *
+ * The table is built over the grid spanned by the rectangles' edges. Within
+ * a grid cell, the number of covering rectangles is constant, and so the
+ * summed area is bilinear in the query coordinates. This allows queries
+ * with arbitrary coordinates and not only those on the grid lines.
+ */
+class OverlapTable {
+public:
+    //! a coordinate, expressed as the preceding grid line and an offset
+    class Position {
+    public:
+        size_t line;
+        long long offset;
+    };
+
+    explicit OverlapTable(const vector<Rectangle>& rects) {
+        for (const auto& r : rects) {
+            if (!r) {
+                // empty rectangles never intersect anything
+                continue;
+            }
+            xs_.push_back(r.x);
+            xs_.push_back(r.x + r.width);
+            ys_.push_back(r.y);
+            ys_.push_back(r.y + r.height);
+        }
+        for (auto* lines : {&xs_, &ys_}) {
+            std::sort(lines->begin(), lines->end());
+            lines->erase(std::unique(lines->begin(), lines->end()), lines->end());
+        }
+        if (xs_.empty()) {
+            return;
+        }
+        // sums_[i * ys_.size() + j] is at first the number of rectangles
+        // covering the cell right below (xs_[i], ys_[j]), computed from
+        // the differences at the rectangle corners
+        sums_.resize(xs_.size() * ys_.size(), 0);
+        for (const auto& r : rects) {
+            if (!r) {
+                continue;
+            }
+            size_t x1 = lineOf(xs_, r.x);
+            size_t x2 = lineOf(xs_, r.x + r.width);
+            size_t y1 = lineOf(ys_, r.y);
+            size_t y2 = lineOf(ys_, r.y + r.height);
+            cell(x1, y1) += 1;
+            cell(x2, y1) -= 1;
+            cell(x1, y2) -= 1;
+            cell(x2, y2) += 1;
+        }
+        accumulate();
+        // weight every cell's count with the cell's area
+        for (size_t i = 0; i + 1 < xs_.size(); i++) {
+            for (size_t j = 0; j + 1 < ys_.size(); j++) {
+                cell(i, j) *= static_cast<long long>(xs_[i + 1] - xs_[i])
+                                * (ys_[j + 1] - ys_[j]);
+            }
+        }
+        // and now, sums_[i * ys_.size() + j] is the covered area (with
+        // multiplicities) left of and above (xs_[i + 1], ys_[j + 1])
+        accumulate();
+    }
+
+    Position xPosition(int x) const { return positionOf(xs_, x); }
+    Position yPosition(int y) const { return positionOf(ys_, y); }
+
+    //! the total intersection area of the rectangle given by its corners
+    long long overlap(Position x1, Position y1, Position x2, Position y2) const {
+        return areaBefore(x2, y2) - areaBefore(x1, y2)
+                - areaBefore(x2, y1) + areaBefore(x1, y1);
+    }
+
+private:
+    static size_t lineOf(const vector<int>& lines, int value) {
+        return std::lower_bound(lines.begin(), lines.end(), value) - lines.begin();
+    }
+
+    static Position positionOf(const vector<int>& lines, int value) {
+        if (lines.empty() || value <= lines.front()) {
+            return { 0, 0 };
+        }
+        if (value >= lines.back()) {
+            // nothing is covered beyond the last grid line
+            return { lines.size() - 1, 0 };
+        }
+        size_t line = std::upper_bound(lines.begin(), lines.end(), value)
+                      - lines.begin() - 1;
+        return { line, value - lines[line] };
+    }
+
+    long long& cell(size_t i, size_t j) {
+        return sums_[i * ys_.size() + j];
+    }
+
+    //! the covered area left of and above the given grid point
+    long long areaAtLine(size_t i, size_t j) const {
+        if (i == 0 || j == 0) {
+            return 0;
+        }
+        return sums_[(i - 1) * ys_.size() + (j - 1)];
+    }
+
+    //! replace every cell by the sum of all cells left of and above it
+    void accumulate() {
+        for (size_t i = 0; i < xs_.size(); i++) {
+            for (size_t j = 0; j < ys_.size(); j++) {
+                long long sum = cell(i, j);
+                if (i > 0) {
+                    sum += cell(i - 1, j);
+                }
+                if (j > 0) {
+                    sum += cell(i, j - 1);
+                }
+                if (i > 0 && j > 0) {
+                    sum -= cell(i - 1, j - 1);
+                }
+                cell(i, j) = sum;
+            }
+        }
+    }
+
+    //! the covered area left of and above the given point
+    long long areaBefore(Position x, Position y) const {
+        if (xs_.empty()) {
+            return 0;
+        }
+        size_t i = x.line;
+        size_t j = y.line;
+        long long area = areaAtLine(i, j);
+        if (x.offset == 0 && y.offset == 0) {
+            return area;
+        }
+        // the area grows linearly with the offsets, and the growth
+        // rate is given by the neighbouring grid points. The divisions
+        // are exact, because the differences are multiples of the
+        // cell widths respectively heights
+        long long width = xs_[i + (x.offset ? 1 : 0)] - xs_[i];
+        long long height = ys_[j + (y.offset ? 1 : 0)] - ys_[j];
+        if (x.offset) {
+            area += x.offset * (areaAtLine(i + 1, j) - areaAtLine(i, j)) / width;
+        }
+        if (y.offset) {
+            area += y.offset * (areaAtLine(i, j + 1) - areaAtLine(i, j)) / height;
+        }
+        if (x.offset && y.offset) {
+            long long cellArea = areaAtLine(i + 1, j + 1) - areaAtLine(i + 1, j)
+                                 - areaAtLine(i, j + 1) + areaAtLine(i, j);
+            area += x.offset * y.offset * cellArea / (width * height);
+        }
+        return area;
+    }
+
+    vector<int> xs_;
+    vector<int> ys_;
+    vector<long long> sums_;
+};
+
 /**
  * @brief Suggest a new position of the client on the given tag.
  * The placement is chosen such that the overlap with other windows is
@@ -452,9 +686,10 @@ Point2D Floating::smartPlacement(HSTag* tag, Client* client, Point2D area, int g
     Point2D clientsize = clientOuter.dimensions();
     // let the client grow by 'gap' to the right and bottom
     clientsize = clientsize + Point2D{ gap, gap };
-    // collect all other rectangles of client windows.
-    // and pair it with their floating property
-    vector<pair<Rectangle,bool>> rects;
+    // collect all other rectangles of client windows,
+    // separated by their floating property
+    vector<Rectangle> floatingRects;
+    vector<Rectangle> tilingRects;
     tag->foreachClient([&](Client* c) {
         if (c != client) {
             bool floating = c->floating_() || tagFloating;
@@ -469,7 +704,11 @@ Point2D Floating::smartPlacement(HSTag* tag, Client* client, Point2D area, int g
             // also let each rectangle grow to the right and bottom
             // by 'gap' pixels
             outline = outline.adjusted(0, 0, gap, gap);
-            rects.push_back(make_pair(outline, floating));
+            if (floating) {
+                floatingRects.push_back(outline);
+            } else {
+                tilingRects.push_back(outline);
+            }
         }
     });
 
@@ -478,11 +717,13 @@ Point2D Floating::smartPlacement(HSTag* tag, Client* client, Point2D area, int g
     std::unordered_set<int> xValues;
     std::unordered_set<int> yValues;
     // use all corners of other windows
-    for (const auto& it : rects) {
-        xValues.insert(it.first.x);
-        xValues.insert(it.first.x + it.first.width);
-        yValues.insert(it.first.y);
-        yValues.insert(it.first.y + it.first.height);
+    for (const auto* rects : {&floatingRects, &tilingRects}) {
+        for (const auto& r : *rects) {
+            xValues.insert(r.x);
+            xValues.insert(r.x + r.width);
+            yValues.insert(r.y);
+            yValues.insert(r.y + r.height);
+        }
     }
     // use screen corners
     xValues.insert(gap); // top
@@ -490,14 +731,47 @@ Point2D Floating::smartPlacement(HSTag* tag, Client* client, Point2D area, int g
     xValues.insert(area.x); // right
     yValues.insert(area.y); // bottom
 
-    // interpret the x/y value picked as the coordinate
-    // of one of the four corners of the 'client'
-    vector<Point2D> windowCorners = {
-        { 0, 0}, // top left
-        { clientsize.x, 0 }, // top right
-        { 0, clientsize.y }, // bottom left
-        { clientsize.x, clientsize.y }, // bottom right
+    // interpret the x/y value picked as the coordinate of one of the
+    // four corners of the 'client'. So the client's left edge is either
+    // on the picked x value or the client's width left of it. Skip
+    // coordinates where the window is not entirely within the screen area
+    auto candidates = [](const std::unordered_set<int>& values, int size, int limit) {
+        std::set<int> result;
+        for (int v : values) {
+            for (int start : { v, v - size }) {
+                if (start >= 0 && start + size <= limit) {
+                    result.insert(start);
+                }
+            }
+        }
+        return result;
+    };
+    std::set<int> lefts = candidates(xValues, clientsize.x, area.x);
+    std::set<int> tops = candidates(yValues, clientsize.y, area.y);
+
+    // the overlaps with all floating (resp. tiling) windows
+    // of each candidate are looked up in a summed-area table
+    OverlapTable floatingOverlap(floatingRects);
+    OverlapTable tilingOverlap(tilingRects);
+    bool emptyClient = clientsize.x <= 0 || clientsize.y <= 0;
+    auto clamped = [emptyClient](long long overlap) {
+        if (emptyClient) {
+            // an empty window does not overlap with anything
+            return 0;
+        }
+        if (overlap > std::numeric_limits<int>::max()) {
+            return std::numeric_limits<int>::max();
+        }
+        return static_cast<int>(overlap);
     };
+    using Span = pair<OverlapTable::Position, OverlapTable::Position>;
+    vector<pair<int, Span>> floatingY, tilingY;
+    for (int y : tops) {
+        floatingY.push_back({y, {floatingOverlap.yPosition(y),
+                                 floatingOverlap.yPosition(y + clientsize.y)}});
+        tilingY.push_back({y, {tilingOverlap.yPosition(y),
+                               tilingOverlap.yPosition(y + clientsize.y)}});
+    }
     // the overlap with floating windows, with tiling windows,
     // and the topleft position:
     std::tuple<int, int, Point2D> best {
@@ -506,50 +780,21 @@ Point2D Floating::smartPlacement(HSTag* tag, Client* client, Point2D area, int g
         Point2D { gap, gap }
     };
     // find the x/y coordinate with the least overlap
-    for (int x : xValues) {
-        for (int y : yValues) {
-            for (const auto& corner : windowCorners) {
-                Rectangle suggested = {
-                    x - corner.x, y - corner.y,
-                    clientsize.x, clientsize.y,
-                };
-                Point2D topleft = suggested.tl();
-                // skip coordinates where the window is not entirely
-                // within the screen area
-                if (topleft.x < 0 || topleft.y < 0) {
-                    continue;
-                }
-                Point2D bottomright = suggested.br();
-                if (bottomright.x > area.x || bottomright.y > area.y) {
-                    continue;
-                }
-                int overlapFloat = 0; // overlap with floating windows
-                int overlapTiling = 0; // overlap with tiling windows
-                for (const auto& otherWindow : rects) {
-                    // compute the intersection with the otherWindow
-                    auto inters = suggested.intersectionWith(otherWindow.first);
-                    if (!inters) {
-                        // no intersection
-                        continue;
-                    }
-                    int delta = abs(inters.width * inters.height);
-                    if (otherWindow.second) {
-                        // if the otherWindow is a floating window
-                        overlapFloat += delta;
-                        if (overlapFloat < 0) {
-                            overlapFloat =  std::numeric_limits<int>::max();
-                        }
-                    } else {
-                        // if the otherWindow is a tiling window
-                        overlapTiling += delta;
-                        if (overlapTiling < 0) {
-                            overlapTiling =  std::numeric_limits<int>::max();
-                        }
-                    }
-                }
-                auto t = std::make_tuple(overlapFloat, overlapTiling, topleft);
-                best = std::min(best, t);
-            }
+    for (int x : lefts) {
+        Span floatingX = { floatingOverlap.xPosition(x),
+                           floatingOverlap.xPosition(x + clientsize.x) };
+        Span tilingX = { tilingOverlap.xPosition(x),
+                         tilingOverlap.xPosition(x + clientsize.x) };
+        for (size_t i = 0; i < floatingY.size(); i++) {
+            const Span& fy = floatingY[i].second;
+            const Span& ty = tilingY[i].second;
+            int overlapFloat = clamped(floatingOverlap.overlap(
+                        floatingX.first, fy.first, floatingX.second, fy.second));
+            int overlapTiling = clamped(tilingOverlap.overlap(
+                        tilingX.first, ty.first, tilingX.second, ty.second));
+            Point2D topleft = { x, floatingY[i].first };
+            auto t = std::make_tuple(overlapFloat, overlapTiling, topleft);
+            best = std::min(best, t);
         }
     }
     // transform the topleft coordinate of the outer window
@@ -27,6 +27,7 @@ public:
     static Point2D smartPlacement(HSTag* tag, Client* client, Point2D area, int gap);
 
 private:
+    static Client* find_client_in_direction(HSTag* tag, Client* curfocus, Direction dir);
     static Point2D find_rectangle_collision_on_tag(HSTag* tag, Client* curfocus, Direction dir, Rectangle curfocusrect = {0,0,-1,-1});
     static bool grow_into_direction(HSTag* tag, Client* client, Direction dir);
     static bool shrink_into_direction(Client* client, Direction dir);
@@ -28,28 +28,11 @@ FrameDecoration::FrameDecoration(FrameLeaf& frame, HSTag* tag_, Settings* settin
     , settings(settings_)
 {
     XConnection& xcon = XConnection::get();
-    // set window attributes
-    XSetWindowAttributes at;
-    at.background_pixel = BlackPixel(xcon.display(), xcon.screen());
-    at.border_pixel = BlackPixel(xcon.display(), xcon.screen());
-    at.override_redirect = True;
-    at.bit_gravity       = StaticGravity;
-    at.event_mask        = SubstructureRedirectMask|SubstructureNotifyMask
-         |ExposureMask|VisibilityChangeMask
-         |EnterWindowMask|LeaveWindowMask|FocusChangeMask
-         |ButtonPress;
-    int mask = CWOverrideRedirect | CWBorderPixel | CWEventMask;
-    if (xcon.usesTransparency()) {
-        mask = mask | CWColormap;
-        at.colormap = xcon.colormap();
-    }
-    window = XCreateWindow(xcon.display(), xcon.root(),
-                        42, 42, 42, 42, settings->frame_border_width(),
-                        // DefaultDepth(xcon.display(), xcon.screen()),
-                        xcon.depth(),
-                        InputOutput,
-                        xcon.visual(),
-                        mask, &at);
+    window = createWindow(settings->frame_border_width(),
+                          SubstructureRedirectMask|SubstructureNotifyMask
+                          |ExposureMask|VisibilityChangeMask
+                          |EnterWindowMask|LeaveWindowMask|FocusChangeMask
+                          |ButtonPress);
 
     // set wm_class for window
     XClassHint *hint = XAllocClassHint();
@@ -97,15 +80,7 @@ void FrameDecoration::render(const FrameDecorationData& data, bool isFocused) {
                       rect.y - bw,
                       rect.width, rect.height);
 
-    if (settings->frame_border_inner_width() > 0
-        && settings->frame_border_inner_width() < settings->frame_border_width()) {
-        set_window_double_border(xcon.display(), window,
-                settings->frame_border_inner_width(),
-                settings->frame_border_inner_color->toX11Pixel(),
-                border_color);
-    } else {
-        XSetWindowBorder(xcon.display(), window, border_color);
-    }
+    setBorderColor(settings, window, border_color);
 
     XSetWindowBackground(xcon.display(), window, bg_color);
     if (settings->frame_bg_transparent() || data.hasClients) {
@@ -178,3 +153,49 @@ FrameDecoration* FrameDecoration::withWindow(Window winid)
     }
 }
 
+/**
+ * @brief create an override-redirect window as it is used for frame
+ * decorations (and for outlines that have to look like them)
+ */
+Window FrameDecoration::createWindow(int borderWidth, long eventMask)
+{
+    XConnection& xcon = XConnection::get();
+    // set window attributes
+    XSetWindowAttributes at;
+    at.background_pixel = BlackPixel(xcon.display(), xcon.screen());
+    at.border_pixel = BlackPixel(xcon.display(), xcon.screen());
+    at.override_redirect = True;
+    at.bit_gravity       = StaticGravity;
+    at.event_mask        = eventMask;
+    int mask = CWOverrideRedirect | CWBorderPixel | CWEventMask;
+    if (xcon.usesTransparency()) {
+        mask = mask | CWColormap;
+        at.colormap = xcon.colormap();
+    }
+    return XCreateWindow(xcon.display(), xcon.root(),
+                         42, 42, 42, 42, borderWidth,
+                         // DefaultDepth(xcon.display(), xcon.screen()),
+                         xcon.depth(),
+                         InputOutput,
+                         xcon.visual(),
+                         mask, &at);
+}
+
+/**
+ * @brief set the border color of a frame decoration window, including
+ * the inner border if frame_border_inner_width is set
+ */
+void FrameDecoration::setBorderColor(Settings* settings, Window win,
+                                     unsigned long borderColor)
+{
+    XConnection& xcon = XConnection::get();
+    if (settings->frame_border_inner_width() > 0
+        && settings->frame_border_inner_width() < settings->frame_border_width()) {
+        set_window_double_border(xcon.display(), win,
+                settings->frame_border_inner_width(),
+                settings->frame_border_inner_color->toX11Pixel(),
+                borderColor);
+    } else {
+        XSetWindowBorder(xcon.display(), win, borderColor);
+    }
+}
@@ -31,6 +31,9 @@ public:
     std::shared_ptr<FrameLeaf> frame();
 
     static FrameDecoration* withWindow(Window winid);
+    static Window createWindow(int borderWidth, long eventMask);
+    static void setBorderColor(Settings* settings, Window win,
+                               unsigned long borderColor);
 
 private:
     static std::map<Window, FrameDecoration*> s_windowToFrameDecoration;
@@ -1,6 +1,6 @@
 #include "frameparser.h"
 
-#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "arglist.h"
@@ -38,19 +38,19 @@ public:
 };
 
 
-FrameParser::FrameParser(string buf) {
-    eofToken = make_pair(buf.size(), "");
-    parse(buf);
+FrameParser::FrameParser(string buf)
+    : buf_(std::move(buf))
+{
+    eofToken = make_pair(buf_.size(), "");
+    parse();
 }
 
-void FrameParser::parse(string buf) {
-    Tokens tokens = tokenize(buf);
+void FrameParser::parse() {
     try {
-        nextToken = tokens.begin();
-        endToken = tokens.end();
+        advance();
         root_ = buildTree();
-        if (nextToken != endToken) {
-            throw ParsingException(*nextToken,
+        if (!atEnd_) {
+            throw ParsingException(nextToken_,
                                    "Layout description too long");
         }
     } catch (const ParsingException& e) {
@@ -59,52 +59,52 @@ void FrameParser::parse(string buf) {
     }
 }
 
-bool FrameParser::contained_in(char c, string s) {
-    return s.find(c) != string::npos;
+bool FrameParser::contained_in(char c, const char* s) {
+    return c != '\0' && strchr(s, c) != nullptr;
 }
 
-FrameParser::Tokens FrameParser::tokenize(string buf) {
-    Tokens tokens;
-    size_t pos = 0;
-    while (pos < buf.size()) {
-        string whitespace = "\n\r ";
-        string parentheses = "()";
-        if (contained_in(buf[pos], whitespace)) {
-            // skip whitespace
-            pos++;
-        } else if (contained_in(buf[pos], parentheses)) {
-            // parentheses are always single character tokens
-            tokens.push_back(make_pair(pos, buf.substr(pos, 1)));
-            pos++;
-        }
-        else {
-            // everything else is a token until the next whitespace character
-            size_t beg = pos;
-            while (pos < buf.size()
-                   && !contained_in(buf[pos], whitespace)
-                   && !contained_in(buf[pos], parentheses))
-            {
-                // scan until whitespace or next token
-                pos++;
-            }
-            tokens.push_back(make_pair(beg, buf.substr(beg, pos - beg)));
+void FrameParser::advance() {
+    const char* whitespace = "\n\r ";
+    const char* parentheses = "()";
+    while (pos_ < buf_.size() && contained_in(buf_[pos_], whitespace)) {
+        // skip whitespace
+        pos_++;
+    }
+    if (pos_ >= buf_.size()) {
+        atEnd_ = true;
+        return;
+    }
+    size_t beg = pos_;
+    if (contained_in(buf_[pos_], parentheses)) {
+        // parentheses are always single character tokens
+        pos_++;
+    } else {
+        // everything else is a token until the next whitespace character
+        while (pos_ < buf_.size()
+               && !contained_in(buf_[pos_], whitespace)
+               && !contained_in(buf_[pos_], parentheses))
+        {
+            // scan until whitespace or next token
+            pos_++;
         }
     }
-    return tokens;
+    nextToken_.first = beg;
+    // re-use the buffer of the previous token
+    nextToken_.second.assign(buf_, beg, pos_ - beg);
 }
 
 shared_ptr<RawFrameNode> FrameParser::buildTree() {
     expectTokens({ "(" });
-    nextToken++;
+    advance();
     expectTokens({ "split", "clients" });
-    bool isSplit = nextToken->second == "split";
-    nextToken++;
+    bool isSplit = nextToken_.second == "split";
+    advance();
     shared_ptr<RawFrameNode> nodeUntyped = nullptr;
     // in both cases, the next token is a list of ':'-separated arguments
-    if (nextToken == endToken) {
+    if (atEnd_) {
         throw ParsingException(eofToken, "Expected argument list");
     }
-    ArgList args (nextToken->second, ':');
+    ArgList args (nextToken_.second, ':');
     if (isSplit) {
         // Construct a RawFrameSplit
         auto node = make_shared<RawFrameSplit>();
@@ -114,7 +114,7 @@ shared_ptr<RawFrameNode> FrameParser::buildTree() {
             stringstream message;
             args.reset();
             message << "Expected 3 arguments but got " << args.size();
-            throw ParsingException(*nextToken, message.str());
+            throw ParsingException(nextToken_, message.str());
         }
         try {
             node->align_ = Converter<SplitAlign>::parse(alignName);
@@ -135,16 +135,16 @@ shared_ptr<RawFrameNode> FrameParser::buildTree() {
                 throw std::invalid_argument("selection must be 0 or 1");
             }
         } catch (const std::exception& e) {
-            throw ParsingException(*nextToken, e.what());
+            throw ParsingException(nextToken_, e.what());
         }
-        nextToken++;
+        advance();
 
         expectTokens({ "(", ")" });
-        if (nextToken->second == "(") {
+        if (nextToken_.second == "(") {
             node->a_ = buildTree();
         }
         expectTokens({ "(", ")" });
-        if (nextToken->second == "(") {
+        if (nextToken_.second == "(") {
             node->b_ = buildTree();
         }
         nodeUntyped = node;
@@ -156,7 +156,7 @@ shared_ptr<RawFrameNode> FrameParser::buildTree() {
             stringstream message;
             args.reset();
             message << "Expected 2 arguments but got " << args.size();
-            throw ParsingException(*nextToken, message.str());
+            throw ParsingException(nextToken_, message.str());
         }
         try {
             node->layout = Converter<LayoutAlgorithm>::parse(layoutName);
@@ -165,53 +165,61 @@ shared_ptr<RawFrameNode> FrameParser::buildTree() {
                 throw std::invalid_argument("selection must not be negative.");
             }
         } catch (const std::exception& e) {
-            throw ParsingException(*nextToken, e.what());
+            throw ParsingException(nextToken_, e.what());
         }
-        nextToken++;
+        advance();
         // Construct a RawFrameLeaf
-        while (nextToken != endToken && nextToken->second != ")") {
+        while (!atEnd_ && nextToken_.second != ")") {
             Window winid;
             try {
                 // if the window id is syntactically wrong, then throw an error
-                winid = Converter<WindowID>::parse(nextToken->second);
+                winid = Converter<WindowID>::parse(nextToken_.second);
             } catch (const std::exception& e) {
-                throw ParsingException(*nextToken, "not a valid window id");
+                throw ParsingException(nextToken_, "not a valid window id");
             }
             // if the window id is unknown, then just print a warning
             Client* client = Root::common().client(winid);
             if (client) {
                 node->clients.push_back(client);
             } else {
-                unknownWindowIDs_.push_back(make_pair(*nextToken, winid));
+                unknownWindowIDs_.push_back(make_pair(nextToken_, winid));
             }
-            nextToken++;
+            advance();
         }
         nodeUntyped = node;
     }
     expectTokens({ ")" });
-    nextToken++;
+    advance();
     return nodeUntyped;
 }
 
-void FrameParser::expectTokens(vector<string> tokens) {
-    if (nextToken == endToken ||
-        std::find(tokens.begin(), tokens.end(), nextToken->second) == tokens.end()) {
+void FrameParser::expectTokens(std::initializer_list<const char*> tokens) {
+    bool found = false;
+    if (!atEnd_) {
+        for (const char* t : tokens) {
+            if (nextToken_.second == t) {
+                found = true;
+                break;
+            }
+        }
+    }
+    if (!found) {
         stringstream message;
-        if (nextToken == endToken) {
+        if (atEnd_) {
             message << "Unexpected end of input.";
         } else {
-            message << "Invalid token \"" << nextToken->second << "\".";
+            message << "Invalid token \"" << nextToken_.second << "\".";
         }
         message << " Expected ";
         if (tokens.size() == 1) {
-            message << "\"" << tokens[0] << "\"";
+            message << "\"" << *tokens.begin() << "\"";
         } else {
             message << "one of:";
             for (auto& t : tokens) {
                 message << " \"" << t << "\"";
             }
         }
-        auto tok = (nextToken == endToken) ? eofToken : *nextToken;
+        auto tok = atEnd_ ? eofToken : nextToken_;
         throw ParsingException(tok, message.str());
     }
 }
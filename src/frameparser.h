@@ -1,8 +1,10 @@
 #pragma once
 
 #include <X11/X.h>
+#include <initializer_list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "framedata.h"
 
@@ -54,9 +56,8 @@ public:
  */
 class FrameParser {
 public:
-    //! a list of tokens and their positions
+    //! a token and its position
     using Token = std::pair<size_t,std::string>;
-    using Tokens = std::vector<Token>;
 
     FrameParser(std::string buf);
     //! the parsing result
@@ -65,23 +66,27 @@ public:
     std::shared_ptr<std::pair<Token,std::string>> error_;
     std::vector<std::pair<Token,Window>> unknownWindowIDs_;
 private:
-    void parse(std::string buf);
-    //! Split a string into tokens. The tokens are defined in the sense that it
-    //is always allowed to insert spaces between tokens. Hence in (a (b c)) the
-    //two closing brackets are separate tokens because (a (b c) ) is
-    //equivalent; however the Leaf-args string "vertical:0" is a single token
-    //because "vertical: 0" is not of valid syntax.
-    Tokens tokenize(std::string buf);
+    void parse();
+    //! Read the next token from the input into nextToken_. The tokens are
+    //defined in the sense that it is always allowed to insert spaces between
+    //tokens. Hence in (a (b c)) the two closing brackets are separate tokens
+    //because (a (b c) ) is equivalent; however the Leaf-args string
+    //"vertical:0" is a single token because "vertical: 0" is not of valid
+    //syntax. The input is scanned only once while building the tree.
+    void advance();
 
-    //! the next token to process by buildTree()
-    Tokens::const_iterator nextToken;
-    Tokens::const_iterator endToken;
-    //! build a RawFrameNode-Tree from the token list
+    const std::string buf_;
+    //! the position in buf_ after nextToken_
+    size_t pos_ = 0;
+    //! the next token to process by buildTree(), only valid if !atEnd_
+    Token nextToken_;
+    bool atEnd_ = false;
+    //! build a RawFrameNode-Tree from the remaining tokens
     std::shared_ptr<RawFrameNode> buildTree();
-    void expectTokens(std::vector<std::string> token);
+    void expectTokens(std::initializer_list<const char*> tokens);
 
     Token eofToken;
 
     //! tells whether the given char is contained in the string
-    static bool contained_in(char c, std::string s);
+    static bool contained_in(char c, const char* s);
 };
@@ -708,19 +708,50 @@ int FrameTree::loadCommand(Input input, Output output) {
         }
         output.error() << endl;
     }
+    tag->frame->loadLayout(parsingResult.root_);
+    tag_update_flags(); // we probably changed some window positions
+    return 0;
+}
+
+void FrameTree::loadLayout(shared_ptr<RawFrameNode> layout)
+{
     // apply the new frame tree
-    tag->frame->applyFrameTree(tag->frame->root_, parsingResult.root_);
-    tag_set_flags_dirty(); // we probably changed some window positions
+    applyFrameTree(root_, layout);
     // arrange monitor
-    Monitor* m = find_monitor_with_tag(tag);
+    Monitor* m = find_monitor_with_tag(tag_);
     if (m) {
-        tag->frame->root_->setVisibleRecursive(true);
+        root_->setVisibleRecursive(true);
         m->applyLayout();
         monitor_update_focus_objects();
     } else {
-        tag->frame->root_->setVisibleRecursive(false);
+        root_->setVisibleRecursive(false);
     }
-    return 0;
+}
+
+/**
+ * @brief Parse the layout on the given line of a snapshot of several
+ * layouts. Syntax errors and unknown window IDs are reported together
+ * with the line number.
+ * @return the parsing result, or nullptr on a syntax error
+ */
+shared_ptr<FrameParser> FrameTree::parseSnapshotLayout(const string& layout,
+                                                       size_t lineNumber,
+                                                       Output output)
+{
+    auto parser = make_shared<FrameParser>(layout);
+    if (parser->error_) {
+        output.perror() << "Line " << lineNumber
+                        << ": Syntax error at "
+                        << parser->error_->first.first << ": "
+                        << parser->error_->second << "\n";
+        return {};
+    }
+    for (const auto& e : parser->unknownWindowIDs_) {
+        output.perror() << "Line " << lineNumber
+                        << ": Warning: Unknown window ID "
+                        << WindowID(e.second).str() << "\n";
+    }
+    return parser;
 }
 
 //! target must not be null, source may be null
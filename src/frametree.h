@@ -16,6 +16,7 @@ class Client;
 class Completion;
 class Frame;
 class FrameLeaf;
+class FrameParser;
 class HSTag;
 class RawFrameNode;
 class Settings;
@@ -89,6 +90,10 @@ public:
     int cycleFrameCommand(Input input, Output output);
     int loadCommand(Input input, Output output);
     void loadCompletion(Completion& complete);
+    //! make the tree look like the given parsing result of FrameParser
+    void loadLayout(std::shared_ptr<RawFrameNode> layout);
+    static std::shared_ptr<FrameParser> parseSnapshotLayout(
+            const std::string& layout, size_t lineNumber, Output output);
     int dumpLayoutCommand(Input input, Output output);
     void dumpLayoutCompletion(Completion& complete);
     int cycleLayoutCommand(Input input, Output output);
@@ -1,12 +1,22 @@
 #include "globalcommands.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
 #include "argparse.h"
 #include "client.h"
 #include "clientmanager.h"
 #include "command.h"
 #include "either.h"
 #include "ewmh.h"
+#include "frameparser.h"
 #include "frametree.h"
+#include "hook.h"
+#include "ipc-protocol.h"
 #include "layout.h"
 #include "metacommands.h"
 #include "monitor.h"
@@ -19,8 +29,12 @@
 
 using std::shared_ptr;
 using std::function;
+using std::make_pair;
+using std::pair;
 using std::string;
+using std::to_string;
 using std::endl;
+using std::vector;
 
 GlobalCommands::GlobalCommands(Root& root)
     : root_(root)
@@ -40,13 +54,21 @@ void GlobalCommands::tagStatusCommand(CallOrComplete invoc)
 
 void GlobalCommands::tagStatus(Monitor* monitor, Output output)
 {
-    tag_update_flags();
     output << '\t';
+    for (const auto& entry : tagStatusEntries(monitor)) {
+        output << entry << '\t';
+    }
+}
+
+vector<string> GlobalCommands::tagStatusEntries(Monitor* monitor)
+{
+    vector<string> entries;
+    entries.reserve(root_.tags->size());
     for (size_t i = 0; i < root_.tags->size(); i++) {
         HSTag* tag = root_.tags->byIdx(i);
         // print flags
         char c = '.';
-        if (tag->flags & TAG_FLAG_USED) {
+        if (tag->flags() & TAG_FLAG_USED) {
             c = ':';
         }
         Monitor* tag_monitor = root_.monitors->byTag(tag);
@@ -61,12 +83,35 @@ void GlobalCommands::tagStatus(Monitor* monitor, Output output)
                 c = '%';
             }
         }
-        if (tag->flags & TAG_FLAG_URGENT) {
+        if (tag->flags() & TAG_FLAG_URGENT) {
             c = '!';
         }
-        output << c;
-        output << *tag->name;
-        output << '\t';
+        entries.push_back(c + tag->name());
+    }
+    return entries;
+}
+
+/**
+ * Panels usually call tag_status after every tag related hook. With the
+ * setting tag_status_hook, the tag status is pushed to them instead, and
+ * only if it really changed.
+ */
+void GlobalCommands::emitTagStatusHooks()
+{
+    if (!root_.settings->tag_status_hook()) {
+        tagStatusHooked_.clear();
+        return;
+    }
+    tagStatusHooked_.resize(root_.monitors->size());
+    for (size_t i = 0; i < tagStatusHooked_.size(); i++) {
+        vector<string> entries = tagStatusEntries(root_.monitors->byIdx(i));
+        if (entries == tagStatusHooked_[i]) {
+            continue;
+        }
+        vector<string> hook = { "tag_status", to_string(i) };
+        hook.insert(hook.end(), entries.begin(), entries.end());
+        hook_emit(hook);
+        tagStatusHooked_[i] = std::move(entries);
     }
 }
 
@@ -283,6 +328,15 @@ void GlobalCommands::closeCommand(CallOrComplete invoc)
     });
 }
 
+//! the stacking order was changed behind the back of the monitors
+void GlobalCommands::forgetStackingOrder()
+{
+    root_.monitors->invalidateRestack();
+    for (Monitor* monitor : *root_.monitors()) {
+        monitor->invalidateRestack();
+    }
+}
+
 void GlobalCommands::raiseCommand(CallOrComplete invoc)
 {
     Either<Client*,WindowID> clientOrWin = {nullptr};
@@ -294,6 +348,7 @@ void GlobalCommands::raiseCommand(CallOrComplete invoc)
         };
         auto forWindowIDs = [&] (WindowID window) {
             XRaiseWindow(root_.X.display(), window);
+            forgetStackingOrder();
         };
         clientOrWin.cases(forClients, forWindowIDs);
         return 0;
@@ -312,6 +367,7 @@ void GlobalCommands::lowerCommand(CallOrComplete invoc)
         };
         auto forWindowIDs = [&] (WindowID window) {
             XLowerWindow(root_.X.display(), window);
+            forgetStackingOrder();
         };
         clientOrWin.cases(forClients, forWindowIDs);
         return 0;
@@ -389,3 +445,314 @@ void GlobalCommands::listClientsCommand(CallOrComplete invoc)
     });
 }
 
+
+//! escape the field separator, line breaks, and backslashes in a session field
+static string escapeSessionField(const string& field)
+{
+    string result;
+    result.reserve(field.size());
+    for (char ch : field) {
+        if (ch == '\\') {
+            result += "\\\\";
+        } else if (ch == '\t') {
+            result += "\\t";
+        } else if (ch == '\n') {
+            result += "\\n";
+        } else {
+            result += ch;
+        }
+    }
+    return result;
+}
+
+//! split a line of a session snapshot into its unescaped fields
+static vector<string> splitSessionLine(const string& line)
+{
+    vector<string> fields = { "" };
+    for (size_t i = 0; i < line.size(); i++) {
+        char ch = line[i];
+        if (ch == '\t') {
+            fields.push_back("");
+        } else if (ch == '\\' && i + 1 < line.size()) {
+            i++;
+            ch = line[i];
+            if (ch == 't') {
+                ch = '\t';
+            } else if (ch == 'n') {
+                ch = '\n';
+            }
+            fields.back() += ch;
+        } else {
+            fields.back() += ch;
+        }
+    }
+    return fields;
+}
+
+/**
+ * @brief Print the session in a line based format. Every line consists of
+ * the type of the entry and its fields, separated by tabs:
+ *
+ *   tag      NAME       LAYOUT
+ *   client   WINID      TAG    FLOATING  MINIMIZED  FLOATING_GEOMETRY
+ *   monitor  INDEX      TAG
+ *   attr     PATH       TYPE   VALUE
+ */
+void GlobalCommands::dumpSessionCommand(CallOrComplete invoc)
+{
+    ArgParse().command(invoc, [&](Output output) {
+        auto printEntry = [&output](const vector<string>& fields) {
+            for (size_t i = 0; i < fields.size(); i++) {
+                if (i > 0) {
+                    output << '\t';
+                }
+                output << escapeSessionField(fields[i]);
+            }
+            output << '\n';
+        };
+        for (HSTag* tag : *root_.tags()) {
+            std::ostringstream layout;
+            OutputChannels channels(output.command(), layout, layout);
+            FrameTree::dump(tag->frame->root_, channels);
+            printEntry({"tag", tag->name(), layout.str()});
+        }
+        vector<Client*> clients;
+        for (const auto& it : root_.clients->clients()) {
+            clients.push_back(it.second);
+        }
+        std::sort(clients.begin(), clients.end(), [](Client* a, Client* b) {
+            return a->window_ < b->window_;
+        });
+        for (Client* client : clients) {
+            printEntry({"client",
+                        client->window_id_str(),
+                        client->tag()->name(),
+                        Converter<bool>::str(client->floating_()),
+                        Converter<bool>::str(client->minimized_()),
+                        Converter<Rectangle>::str(client->float_size_()),
+                       });
+        }
+        for (Monitor* monitor : *root_.monitors()) {
+            printEntry({"monitor",
+                        to_string(monitor->index()),
+                        monitor->tag->name(),
+                       });
+        }
+        root_.meta_commands->forEachUserAttribute(
+                    [&](const string& path, Attribute* attribute) {
+            printEntry({"attr", path, attribute->typestr(), attribute->str()});
+        });
+        return HERBST_EXIT_SUCCESS;
+    });
+}
+
+namespace {
+//! the state of a client in a session snapshot
+class ClientSnapshot {
+public:
+    Client* client_ = nullptr;
+    string tag_;
+    bool floating_ = false;
+    bool minimized_ = false;
+    Rectangle floatingGeometry_;
+};
+
+//! a user attribute in a session snapshot
+class UserAttributeSnapshot {
+public:
+    size_t lineNumber_ = 0;
+    string path_;
+    string type_;
+    string value_;
+};
+}
+
+/**
+ * @brief Restore a session printed by dump_session. The entire snapshot
+ * is parsed before anything is changed, and the monitors are locked while
+ * the snapshot is applied such that every monitor is laid out only once.
+ */
+void GlobalCommands::loadSessionCommand(CallOrComplete invoc)
+{
+    string snapshot;
+    ArgParse().mandatory(snapshot)
+            .command(invoc, [&](Output output) {
+        static const std::map<string, size_t> fieldCount = {
+            {"tag", 3},
+            {"client", 6},
+            {"monitor", 3},
+            {"attr", 4},
+        };
+        vector<pair<string, shared_ptr<FrameParser>>> layouts;
+        std::unordered_set<string> tagNames;
+        vector<ClientSnapshot> clients;
+        vector<pair<Monitor*, string>> monitorTags;
+        vector<UserAttributeSnapshot> attributes;
+        auto requireTag = [&](const string& name) {
+            if (!tagNames.count(name) && !root_.tags->find(name)) {
+                throw std::invalid_argument("Tag \"" + name + "\" not found");
+            }
+        };
+        size_t lineNumber = 0;
+        std::istringstream lines(snapshot);
+        string line;
+        while (std::getline(lines, line)) {
+            lineNumber++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            vector<string> fields = splitSessionLine(line);
+            auto expected = fieldCount.find(fields[0]);
+            if (expected == fieldCount.end()) {
+                output.perror() << "Line " << lineNumber
+                                << ": Unknown entry type \"" << fields[0] << "\"\n";
+                return HERBST_INVALID_ARGUMENT;
+            }
+            if (fields.size() != expected->second) {
+                output.perror() << "Line " << lineNumber
+                                << ": Expected " << (expected->second - 1)
+                                << " fields for \"" << fields[0]
+                                << "\" but got " << (fields.size() - 1) << "\n";
+                return HERBST_INVALID_ARGUMENT;
+            }
+            try {
+                if (fields[0] == "tag") {
+                    if (fields[1].empty()) {
+                        throw std::invalid_argument("An empty tag name is not permitted");
+                    }
+                    auto parser = FrameTree::parseSnapshotLayout(fields[2],
+                                                                 lineNumber, output);
+                    if (!parser) {
+                        return HERBST_INVALID_ARGUMENT;
+                    }
+                    layouts.push_back(make_pair(fields[1], parser));
+                    tagNames.insert(fields[1]);
+                } else if (fields[0] == "client") {
+                    ClientSnapshot state;
+                    WindowID window = Converter<WindowID>::parse(fields[1]);
+                    state.client_ = root_.clients->client(window);
+                    state.tag_ = fields[2];
+                    requireTag(state.tag_);
+                    state.floating_ = Converter<bool>::parse(fields[3]);
+                    state.minimized_ = Converter<bool>::parse(fields[4]);
+                    state.floatingGeometry_ = Converter<Rectangle>::parse(fields[5]);
+                    if (!state.client_) {
+                        output.perror() << "Line " << lineNumber
+                                        << ": Warning: Unknown window ID "
+                                        << window.str() << "\n";
+                        continue;
+                    }
+                    clients.push_back(state);
+                } else if (fields[0] == "monitor") {
+                    requireTag(fields[2]);
+                    Monitor* monitor = root_.monitors->byString(fields[1]);
+                    if (!monitor) {
+                        output.perror() << "Line " << lineNumber
+                                        << ": Warning: No such monitor: "
+                                        << fields[1] << "\n";
+                        continue;
+                    }
+                    monitorTags.push_back(make_pair(monitor, fields[2]));
+                } else {
+                    UserAttributeSnapshot attribute;
+                    attribute.lineNumber_ = lineNumber;
+                    attribute.path_ = fields[1];
+                    attribute.type_ = fields[2];
+                    attribute.value_ = fields[3];
+                    attributes.push_back(attribute);
+                }
+            } catch (const std::exception& e) {
+                output.perror() << "Line " << lineNumber << ": " << e.what() << "\n";
+                return HERBST_INVALID_ARGUMENT;
+            }
+        }
+        // check the user attributes once all tags are known, because an
+        // attribute may belong to a tag that is only created by the snapshot
+        vector<UserAttributeSnapshot> validAttributes;
+        std::map<string, string> attributeTypes;
+        for (const auto& attribute : attributes) {
+            auto previous = attributeTypes.find(attribute.path_);
+            if (previous != attributeTypes.end()
+                && previous->second != attribute.type_) {
+                output.perror() << "Line " << attribute.lineNumber_
+                                << ": attribute \"" << attribute.path_
+                                << "\" has type " << previous->second
+                                << " instead of " << attribute.type_ << "\n";
+                return HERBST_INVALID_ARGUMENT;
+            }
+            attributeTypes[attribute.path_] = attribute.type_;
+            auto objectPath = Object::splitPath(attribute.path_).first;
+            vector<string> components(objectPath.begin(), objectPath.end());
+            bool onNewTag = components.size() == 3
+                    && components[0] == "tags" && components[1] == "by-name"
+                    && tagNames.count(components[2])
+                    && !root_.tags->find(components[2]);
+            Object* object = root_.child(objectPath);
+            if (!object && !onNewTag) {
+                output.perror() << "Line " << attribute.lineNumber_
+                                << ": Warning: No such object: "
+                                << objectPath.join() << "\n";
+                continue;
+            }
+            std::ostringstream message;
+            OutputChannels channels("", message, message);
+            if (!root_.meta_commands->userAttributeValid(object, attribute.path_,
+                                                         attribute.type_,
+                                                         attribute.value_, channels)) {
+                string text = message.str();
+                if (text.empty() || text.back() != '\n') {
+                    text += '\n';
+                }
+                output.perror() << "Line " << attribute.lineNumber_ << ": " << text;
+                return HERBST_INVALID_ARGUMENT;
+            }
+            validAttributes.push_back(attribute);
+        }
+
+        root_.monitors->lock();
+        for (const auto& entry : layouts) {
+            if (!root_.tags->find(entry.first)) {
+                HSTag* tag = root_.tags->add_tag(entry.first);
+                hook_emit({"tag_added", tag->name()});
+            }
+        }
+        for (const auto& state : clients) {
+            Client* client = state.client_;
+            root_.tags->moveClient(client, root_.tags->find(state.tag_), {}, false);
+            client->float_size_ = state.floatingGeometry_;
+            client->minimized_ = state.minimized_;
+            client->floating_ = state.floating_;
+        }
+        // the layouts put the tiled clients to their exact positions
+        for (const auto& entry : layouts) {
+            root_.tags->find(entry.first)->frame->loadLayout(entry.second->root_);
+        }
+        // the monitors swap their tags regardless of the setting
+        // swap_monitors_to_get_tag, such that every tag ends up on
+        // the monitor given in the snapshot
+        for (const auto& entry : monitorTags) {
+            Monitor* monitor = entry.first;
+            HSTag* tag = root_.tags->find(entry.second);
+            if (monitor->tag == tag) {
+                continue;
+            }
+            Monitor* other = root_.monitors->byTag(tag);
+            if (monitor->lock_tag() || (other && other->lock_tag())) {
+                output.perror() << "Warning: Can not show tag \"" << tag->name()
+                                << "\" on monitor " << monitor->index()
+                                << " because the tag of a monitor is locked\n";
+                continue;
+            }
+            monitor_set_tag(monitor, tag, true);
+        }
+        for (const auto& attribute : validAttributes) {
+            root_.meta_commands->setUserAttribute(attribute.path_, attribute.type_,
+                                                  attribute.value_, true, output);
+        }
+        // lay out every monitor whose content changed
+        root_.monitors->unlock();
+        monitor_update_focus_objects();
+        tag_update_flags();
+        return HERBST_EXIT_SUCCESS;
+    });
+}
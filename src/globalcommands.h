@@ -1,6 +1,9 @@
 #ifndef GLOBALCOMMANDS_H
 #define GLOBALCOMMANDS_H
 
+#include <string>
+#include <vector>
+
 #include "commandio.h"
 
 class Client;
@@ -20,6 +23,10 @@ public:
     GlobalCommands(Root& root);
     void tagStatusCommand(CallOrComplete invoc);
     void tagStatus(Monitor* monitor, Output output);
+    //! the tab separated fields printed by tag_status
+    std::vector<std::string> tagStatusEntries(Monitor* monitor);
+    //! emit the tag_status hook for every monitor whose status changed
+    void emitTagStatusHooks();
 
     int focusEdgeCommand(Input input, Output output);
     void focusEdgeCompletion(Completion& complete);
@@ -47,8 +54,14 @@ public:
     void focusNthCommand(CallOrComplete invoc);
 
     void listClientsCommand(CallOrComplete invoc);
+
+    void dumpSessionCommand(CallOrComplete invoc);
+    void loadSessionCommand(CallOrComplete invoc);
 private:
+    void forgetStackingOrder();
     Root& root_;
+    //! the tag status announced last for each monitor
+    std::vector<std::vector<std::string>> tagStatusHooked_;
 };
 
 #endif // GLOBALCOMMANDS_H
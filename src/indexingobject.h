@@ -3,13 +3,16 @@
 
 #include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "attribute_.h"
 #include "object.h"
 
 /** an object that carries a vector of children objects, each accessible by its
- * index
+ * index. The indexed children are not stored in the string-keyed children
+ * map of Object, so removing or moving a child only updates the indices of
+ * the following children. This is announced once via indicesChanged.
  */
 template<typename T>
 class IndexingObject : public Object {
@@ -21,9 +24,9 @@ public:
         // the current array size is the index for the new child
         unsigned long index = data.size();
         data.push_back(newChild);
-        // add a child object
-        addChild(newChild, std::to_string(index));
+        indices_[newChild] = index;
         newChild->setIndexAttribute(index);
+        notifyHooks(HookEvent::CHILD_ADDED, std::to_string(index));
     }
     ~IndexingObject() override {
         clearChildren();
@@ -36,28 +39,29 @@ public:
         }
 
         T* child = byIdx(idx);
+        // announce the removal while the child is still accessible
+        notifyHooks(HookEvent::CHILD_REMOVED, std::to_string(idx));
         data.erase(data.begin() + idx);
-
-        removeChild(std::to_string(idx));
+        indices_.erase(child);
 
         // Update indices for remaining children
         for (size_t new_idx = idx; new_idx < data.size(); new_idx++) {
-            std::string old_idx_str = std::to_string(new_idx + 1);
-            removeChild(old_idx_str);
-            addChild(data[new_idx], std::to_string(new_idx));
+            indices_[data[new_idx]] = new_idx;
             data[new_idx]->setIndexAttribute(new_idx);
         }
 
         delete child;
+        if (idx < data.size()) {
+            indicesChanged.emit();
+        }
     }
 
     int index_of(T* child) {
-        for (size_t i = 0; i < data.size(); i++) {
-            if (&* data[i] == child) {
-                return i;
-            }
+        auto it = indices_.find(child);
+        if (it == indices_.end()) {
+            return -1;
         }
-        return -1;
+        return static_cast<int>(it->second);
     }
 
     T& operator[](size_t idx) {
@@ -75,12 +79,13 @@ public:
     // remove all "indexed" children
     void clearChildren() {
         for (size_t idx = 0; idx < data.size(); idx++) {
-            removeChild(std::to_string(idx));
+            notifyHooks(HookEvent::CHILD_REMOVED, std::to_string(idx));
         }
         for (auto child : data) {
             delete child;
         }
         data.erase(data.begin(), data.end());
+        indices_.clear();
     }
 
     void indexChangeRequested(T* object, size_t newIndex) {
@@ -114,27 +119,37 @@ public:
         data[oldIndex] = lastValue;
         // for each of these, update the index
         for (size_t i = newIndex; i != oldIndex; i+= delta) {
+            indices_[data[i]] = i;
             data[i]->setIndexAttribute(i);
-            addChild(data[i], std::to_string(i));
         }
+        indices_[data[oldIndex]] = oldIndex;
         data[oldIndex]->setIndexAttribute(oldIndex);
-        addChild(data[oldIndex], std::to_string(oldIndex));
         indicesChanged.emit();
     }
 
     DynAttribute_<unsigned long> count;
+    //! emitted once whenever the index of some existing children changed
     Signal indicesChanged;
 
     // iterators
     typedef typename std::vector<T*>::iterator iterator_type;
     iterator_type begin() { return data.begin(); }
     iterator_type end() { return data.end(); }
+protected:
+    size_t indexedChildCount() override {
+        return data.size();
+    }
+    Object* indexedChild(size_t index) override {
+        return byIdx(index);
+    }
 private:
     unsigned long sizeUnsignedLong() {
         return static_cast<unsigned long>(data.size());
     }
 
     std::vector<T*> data;
+    //! the index of each element of data
+    std::unordered_map<T*, size_t> indices_;
 };
 
 
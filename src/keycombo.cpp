@@ -155,6 +155,12 @@ bool KeyCombo::operator==(const KeyCombo& other) const {
     return sameMods && sameKeySym;
 }
 
+size_t KeyCombo::Hash::operator()(const KeyCombo& combo) const {
+    // modifier masks only occupy the lowest 8 bits, so shifting the keysym
+    // keeps the two parts apart
+    return std::hash<KeySym>()((combo.keysym << 8) ^ combo.modifiers_);
+}
+
 //! Splits a given key combo string into a list of tokens
 vector<string> ModifierCombo::tokensFromString(string keySpec)
 {
@@ -73,5 +73,11 @@ public:
     static std::vector<std::string> getPossibleKeySyms();
     static void complete(Completion& complete);
 
+    //! hash functor such that KeyCombo can be used as a key in std::unordered_map
+    class Hash {
+    public:
+        size_t operator()(const KeyCombo& combo) const;
+    };
+
     KeySym keysym = {};
 };
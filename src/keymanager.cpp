@@ -1,6 +1,8 @@
 #include "keymanager.h"
 
+#include <X11/Xutil.h>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
@@ -14,29 +16,99 @@
 #include "ipc-protocol.h"
 #include "keycombo.h"
 #include "root.h"
+#include "settings.h"
 #include "utils.h"
 
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
 using std::endl;
+using std::make_pair;
 using std::string;
 using std::unique_ptr;
+using std::vector;
+
+constexpr const char* KeyManager::defaultMode;
+
+//! the prefix of the optional flag selecting the mode of a binding
+static const string modeFlagPrefix = "--mode=";
+
+//! the maximum number of keymask pairs whose results are remembered
+static const size_t maxKeyMaskResults = 16;
+
+KeyManager::KeyManager()
+    : mode(this, "mode", "default", &KeyManager::isValidMode)
+    , modeSwitchDuration(this, "mode_switch_usec", 0)
+{
+    mode.changed().connect(this, &KeyManager::modeChanged);
+    mode.setDoc("the name of the active key binding mode. Only the key "
+                "bindings of this mode are grabbed.");
+    modeSwitchDuration.setDoc("the time in microseconds it took to "
+                              "apply the last change of \'mode\'");
+}
 
 KeyManager::~KeyManager() {
     xKeyGrabber_.ungrabAll();
 }
 
+/*!
+ * If the next token of the input is a --mode=NAME flag, then consume it
+ * and write the mode's name to the given modeName.
+ *
+ * \return Whether the flag was present
+ */
+bool KeyManager::parseModeFlag(Input& input, string& modeName) {
+    if (input.empty() || input.front().rfind(modeFlagPrefix, 0) != 0) {
+        return false;
+    }
+    modeName = input.front().substr(modeFlagPrefix.size());
+    input.shift();
+    return true;
+}
+
+/*!
+ * Parses a space separated list of key combos, e.g. "Mod1-i 1"
+ *
+ * \throws meaningful exceptions on parsing errors
+ */
+vector<KeyCombo> KeyManager::chainFromString(const string& str) {
+    vector<KeyCombo> chain;
+    for (const auto& token : ArgList::split(str, ' ')) {
+        if (!token.empty()) {
+            chain.push_back(KeyCombo::fromString(token));
+        }
+    }
+    if (chain.empty()) {
+        // let the parser produce the error message
+        chain.push_back(KeyCombo::fromString(str));
+    }
+    return chain;
+}
+
 int KeyManager::addKeybindCommand(Input input, Output output) {
+    auto newBinding = make_unique<KeyBinding>();
+    newBinding->mode = defaultMode;
+    bool hasModeFlag = parseModeFlag(input, newBinding->mode);
     if (input.size() < 2) {
         return HERBST_NEED_MORE_ARGS;
     }
-
-    auto newBinding = make_unique<KeyBinding>();
+    if (hasModeFlag && newBinding->mode.empty()) {
+        output.perror() << "the mode name must not be empty" << endl;
+        return HERBST_INVALID_ARGUMENT;
+    }
 
     try {
-        newBinding->keyCombo = KeyCombo::fromString(input.front());
+        newBinding->chain = chainFromString(input.front());
     } catch (std::exception &error) {
         output.perror() << error.what() << endl;
         return HERBST_INVALID_ARGUMENT;
     }
+    vector<string> names;
+    for (const auto& combo : newBinding->chain) {
+        names.push_back(combo.str());
+    }
+    newBinding->name = join_strings(names, " ");
 
     input.shift();
     // Store remaining input as the associated command
@@ -50,19 +122,25 @@ int KeyManager::addKeybindCommand(Input input, Output output) {
         return HERBST_COMMAND_NOT_FOUND;
     }
 
-    // Make sure there is no existing binding with same keysym/modifiers
-    removeKeyBinding(newBinding->keyCombo);
-
-    if (currentKeyMask_.allowsBinding(newBinding->keyCombo)
-        && currentKeysInactive_.allowsBinding(newBinding->keyCombo))
-    {
-        // Grab for events on this keycode
-        xKeyGrabber_.grabKeyCombo(newBinding->keyCombo);
-        newBinding->grabbed = true;
-    }
+    // Make sure there is no existing binding with same keysym/modifiers.
+    // For key chains, this also covers bindings that are a prefix of the
+    // new binding (or vice versa). All of these share the first combo
+    bool replacedBindings =
+        removeKeyBinding(newBinding->mode, newBinding->chain, true);
 
     // Add keybinding to list
     binds.push_back(std::move(newBinding));
+    bindingsChanged();
+    leaveChain();
+
+    const KeyBinding& added = *binds.back();
+    if (added.mode == mode() && isAllowed(added)) {
+        // Grab for events on this keycode
+        xKeyGrabber_.grabKeyCombo(added.chain.front());
+    } else if (replacedBindings) {
+        // the replaced bindings might have been the reason for a grab
+        applyGrabs();
+    }
 
     ensureKeyMask();
 
@@ -71,8 +149,11 @@ int KeyManager::addKeybindCommand(Input input, Output output) {
 
 int KeyManager::listKeybindsCommand(Output output) const {
     for (auto& binding : binds) {
+        if (binding->mode != defaultMode) {
+            output << modeFlagPrefix << binding->mode << "\t";
+        }
         // add key combo
-        output << binding->keyCombo.str();
+        output << binding->name;
         // add associated command
         output << "\t" << ArgList(binding->cmd).join('\t');
         output << "\n";
@@ -81,6 +162,8 @@ int KeyManager::listKeybindsCommand(Output output) const {
 }
 
 int KeyManager::removeKeybindCommand(Input input, Output output) {
+    string modeName = defaultMode;
+    parseModeFlag(input, modeName);
     string arg;
     if (!(input >> arg)) {
         return HERBST_NEED_MORE_ARGS;
@@ -88,78 +171,165 @@ int KeyManager::removeKeybindCommand(Input input, Output output) {
 
     if (arg == "--all" || arg == "-F") {
         binds.clear();
+        bindingsChanged();
+        leaveChain();
         xKeyGrabber_.ungrabAll();
+        mode = defaultMode;
     } else {
-        KeyCombo comboToRemove = {};
+        vector<KeyCombo> chainToRemove;
         try {
-            comboToRemove = KeyCombo::fromString(arg);
+            chainToRemove = chainFromString(arg);
         } catch (std::exception &error) {
             output.perror() << arg << ": " << error.what() << "\n";
             return HERBST_INVALID_ARGUMENT;
         }
 
         // Remove binding (or moan if none was found)
-        if (removeKeyBinding(comboToRemove)) {
-            regrabAll();
-        } else {
+        if (!removeKeyBinding(modeName, chainToRemove, false)) {
             output.perror() << "Key \"" << arg << "\" is not bound\n";
             return HERBST_INVALID_ARGUMENT;
         }
+        bindingsChanged();
+        leaveChain();
+        if (modeName == mode()) {
+            if (isValidMode(modeName).empty()) {
+                applyGrabs();
+            } else {
+                // the active mode has no bindings anymore
+                mode = defaultMode;
+            }
+        }
     }
 
     return HERBST_EXIT_SUCCESS;
 }
 
 void KeyManager::addKeybindCompletion(Completion &complete) {
+    compileStates();
+    size_t keyIndex =
+        (complete > 0 && complete[0].rfind(modeFlagPrefix, 0) == 0) ? 1 : 0;
     if (complete == 0) {
+        complete.partial(modeFlagPrefix);
+        for (const auto& it : modeStates_) {
+            complete.full(modeFlagPrefix + it.first);
+        }
+    }
+    if (complete == keyIndex) {
         KeyCombo::complete(complete);
-    } else {
-        complete.completeCommands(1);
+    } else if (complete > keyIndex) {
+        complete.completeCommands(keyIndex + 1);
     }
 }
 
 void KeyManager::removeKeybindCompletion(Completion &complete) {
+    compileStates();
+    size_t keyIndex =
+        (complete > 0 && complete[0].rfind(modeFlagPrefix, 0) == 0) ? 1 : 0;
+    string modeName = keyIndex ? complete[0].substr(modeFlagPrefix.size()) : defaultMode;
     if (complete == 0) {
         complete.full({ "-F", "--all" });
-
+        for (const auto& it : modeStates_) {
+            complete.full(modeFlagPrefix + it.first);
+        }
+    }
+    if (complete == keyIndex) {
         for (auto& binding : binds) {
-            complete.full(binding->keyCombo.str());
+            if (binding->mode == modeName) {
+                complete.full(binding->name);
+            }
         }
     }
 }
 
-void KeyManager::handleKeyPress(XKeyEvent* ev) const {
+void KeyManager::handleKeyPress(XKeyEvent* ev) {
     KeyCombo pressed = xKeyGrabber_.xEventToKeyCombo(ev);
+    compileStates();
 
-    auto found = std::find_if(binds.begin(), binds.end(),
-            [=](const unique_ptr<KeyBinding> &other) {
-                return pressed == other->keyCombo;
-            });
-    if (found != binds.end()) {
-        // execute the bound command
+    size_t stateIdx;
+    if (inChain_) {
+        stateIdx = chainState_;
+    } else {
+        auto modeIt = modeStates_.find(mode());
+        if (modeIt == modeStates_.end()) {
+            return;
+        }
+        stateIdx = modeIt->second;
+    }
+    KeyState& state = states_[stateIdx];
+
+    auto found = state.bindings.find(pressed);
+    if (found != state.bindings.end() && isAllowed(*found->second)) {
+        // execute the bound command. Copy it, because the command might
+        // remove the binding itself
+        leaveChain();
         std::ostringstream discardedOutput;
-        auto& cmd = (*found)->cmd;
+        auto cmd = found->second->cmd;
         Input input(cmd.front(), {cmd.begin() + 1, cmd.end()});
         // discard output, but forward errors to std::cerr
         OutputChannels channels(cmd.front(), discardedOutput, std::cerr);
         Commands::call(input, channels);
+        return;
+    }
+    auto transition = state.transitions.find(pressed);
+    if (transition != state.transitions.end()) {
+        // a prefix of a key chain was pressed. Grab the entire keyboard
+        // until the chain is completed or aborted
+        if (!inChain_) {
+            xKeyGrabber_.grabKeyboard();
+            inChain_ = true;
+        }
+        chainState_ = transition->second;
+        unsigned long timeout = g_settings->keychain_timeout();
+        if (timeout > 0) {
+            chainDeadline_ = steady_clock::now() + milliseconds(timeout);
+        } else {
+            chainDeadline_ = {};
+        }
+    } else if (inChain_ && !IsModifierKey(pressed.keysym)) {
+        // any other key, e.g. Escape, aborts the chain
+        leaveChain();
     }
 }
 
-void KeyManager::regrabAll() {
-    xKeyGrabber_.updateNumlockMask();
+std::experimental::optional<microseconds> KeyManager::keyChainTimeout()
+{
+    if (!chainDeadline_) {
+        return {};
+    }
+    auto now = steady_clock::now();
+    if (*chainDeadline_ <= now) {
+        return microseconds(0);
+    }
+    return duration_cast<microseconds>(*chainDeadline_ - now);
+}
 
-     // Remove all current grabs:
-    xKeyGrabber_.ungrabAll();
+//! Abort the pending key chain if it has not been continued in time
+void KeyManager::leaveChainIfDue()
+{
+    auto timeout = keyChainTimeout();
+    if (timeout && timeout->count() == 0) {
+        leaveChain();
+    }
+}
 
-    for (auto& binding : binds) {
-        // grab precisely those again, that have been grabbed before
-        if (binding->grabbed) {
-            xKeyGrabber_.grabKeyCombo(binding->keyCombo);
-        }
+//! Leave the current key chain (if any) and release the keyboard grab
+void KeyManager::leaveChain() {
+    chainDeadline_ = {};
+    if (inChain_) {
+        inChain_ = false;
+        xKeyGrabber_.ungrabKeyboard();
     }
 }
 
+/*!
+ * Grabs all keys again after the keyboard or modifier mapping has changed
+ */
+void KeyManager::regrabAll() {
+    xKeyGrabber_.updateNumlockMask();
+    // grab precisely those again, that have been grabbed before
+    xKeyGrabber_.regrabAll();
+}
+
 /*!
  * Makes sure that the currently active keymask is correct for the currently
  * focused client and regrabs keys if necessary
@@ -196,20 +366,10 @@ void KeyManager::ensureKeyMask(const Client* client) {
 
 //! Apply new keymask by grabbing/ungrabbing current bindings accordingly
 void KeyManager::setActiveKeyMask(const KeyMask& keyMask, const KeyMask& keysInactive) {
-    for (auto& binding : binds) {
-        auto name = binding->keyCombo.str();
-        bool isAllowed = keysInactive.allowsBinding(binding->keyCombo)
-                         && keyMask.allowsBinding(binding->keyCombo);
-        if (isAllowed && !binding->grabbed) {
-            xKeyGrabber_.grabKeyCombo(binding->keyCombo);
-            binding->grabbed = true;
-        } else if (!isAllowed && binding->grabbed) {
-            xKeyGrabber_.ungrabKeyCombo(binding->keyCombo);
-            binding->grabbed = false;
-        }
-    }
     currentKeyMask_ = keyMask;
     currentKeysInactive_ = keysInactive;
+    activeResults_ = nullptr;
+    applyGrabs();
 }
 
 //! Set the current key filters to an empty exception
@@ -218,26 +378,168 @@ void KeyManager::clearActiveKeyMask() {
 }
 
 /*!
- * Removes a given key combo from the list of bindings (no ungrabbing)
+ * Whether the binding is allowed by the currently active keymasks. The
+ * regexes are evaluated at most once per binding and pair of keymasks
+ * until the bindings change.
+ */
+bool KeyManager::isAllowed(const KeyBinding& binding) {
+    auto& allowed = activeResults().allowed;
+    auto it = allowed.find(&binding);
+    if (it == allowed.end()) {
+        bool value = currentKeysInactive_.allowsBinding(binding)
+            && currentKeyMask_.allowsBinding(binding);
+        it = allowed.insert({&binding, value}).first;
+    }
+    return it->second;
+}
+
+//! The cached results for the currently active keymasks
+KeyManager::KeyMaskResults& KeyManager::activeResults() {
+    if (!activeResults_) {
+        auto key = make_pair(currentKeyMask_.str(), currentKeysInactive_.str());
+        auto it = keyMaskResults_.find(key);
+        if (it == keyMaskResults_.end()) {
+            if (keyMaskResults_.size() >= maxKeyMaskResults) {
+                // forget everything instead of tracking which entry
+                // was used least recently
+                keyMaskResults_.clear();
+            }
+            it = keyMaskResults_.insert({key, {}}).first;
+        }
+        activeResults_ = &(it->second);
+    }
+    return *activeResults_;
+}
+
+/*!
+ * To be called whenever bindings are added or removed: all compiled
+ * or cached data about the bindings is outdated then
+ */
+void KeyManager::bindingsChanged() {
+    statesValid_ = false;
+    keyMaskResults_.clear();
+    activeResults_ = nullptr;
+}
+
+//! A mode is valid if it is the default mode or if it has bindings
+string KeyManager::isValidMode(string modeName) {
+    if (modeName == defaultMode) {
+        return {};
+    }
+    for (auto& binding : binds) {
+        if (binding->mode == modeName) {
+            return {};
+        }
+    }
+    return "there are no key bindings in mode \"" + modeName + "\"";
+}
+
+//! Switch the grabbed keys to the bindings of the new mode
+void KeyManager::modeChanged() {
+    auto start = steady_clock::now();
+    leaveChain();
+    applyGrabs();
+    auto duration = steady_clock::now() - start;
+    modeSwitchDuration =
+        duration_cast<microseconds>(duration).count();
+}
+
+/*!
+ * Build the transition table from the current bindings,
+ * unless it is still up to date.
+ */
+void KeyManager::compileStates() {
+    if (statesValid_) {
+        return;
+    }
+    states_.clear();
+    modeStates_.clear();
+    for (auto& binding : binds) {
+        auto modeIt = modeStates_.find(binding->mode);
+        if (modeIt == modeStates_.end()) {
+            states_.push_back({});
+            modeIt = modeStates_.insert({binding->mode, states_.size() - 1}).first;
+        }
+        size_t stateIdx = modeIt->second;
+        states_[stateIdx].modeBindings.push_back(binding.get());
+        // walk along the chain, creating states for its prefixes
+        for (size_t i = 0; i + 1 < binding->chain.size(); i++) {
+            auto& transitions = states_[stateIdx].transitions;
+            auto next = transitions.find(binding->chain[i]);
+            if (next != transitions.end()) {
+                stateIdx = next->second;
+            } else {
+                transitions[binding->chain[i]] = states_.size();
+                stateIdx = states_.size();
+                // this invalidates the 'transitions' reference
+                states_.push_back({});
+            }
+        }
+        states_[stateIdx].bindings[binding->chain.back()] = binding.get();
+    }
+    statesValid_ = true;
+}
+
+/*!
+ * The combos to be grabbed in the given mode: the first combo of every
+ * binding that is allowed by the current keymasks. The result is cached
+ * per pair of keymasks until the bindings change.
+ */
+const XKeyGrabber::KeyComboSet& KeyManager::grabSet(const string& modeName) {
+    static const XKeyGrabber::KeyComboSet nothing;
+    compileStates();
+    auto modeIt = modeStates_.find(modeName);
+    if (modeIt == modeStates_.end()) {
+        return nothing;
+    }
+    auto& grabSets = activeResults().grabSets;
+    auto cached = grabSets.find(modeName);
+    if (cached != grabSets.end()) {
+        return cached->second;
+    }
+    XKeyGrabber::KeyComboSet& result = grabSets[modeName];
+    for (auto binding : states_[modeIt->second].modeBindings) {
+        if (isAllowed(*binding)) {
+            result.insert(binding->chain.front());
+        }
+    }
+    return result;
+}
+
+//! Send the difference between the grabbed keys and the active mode's keys
+void KeyManager::applyGrabs() {
+    xKeyGrabber_.setGrabbedKeys(grabSet(mode()));
+}
+
+/*!
+ * Removes the binding with the given chain from the list of bindings of the
+ * given mode (no ungrabbing). If prefixesConflict is set, then also every
+ * binding is removed whose chain is a prefix of the given chain or vice versa.
  *
  * \return True if a matching binding was found and removed
  * \return False if no matching binding was found
  */
-bool KeyManager::removeKeyBinding(const KeyCombo& comboToRemove) {
-    // Find binding to remove
-    auto removeIter = binds.begin();
-    for (; removeIter != binds.end(); removeIter++) {
-        if (comboToRemove == (*removeIter)->keyCombo) {
-            break;
+bool KeyManager::removeKeyBinding(const string& modeName,
+                                  const vector<KeyCombo>& chain,
+                                  bool prefixesConflict) {
+    auto matches = [&](const unique_ptr<KeyBinding>& binding) {
+        if (binding->mode != modeName) {
+            return false;
         }
-    }
-
+        if (!prefixesConflict) {
+            return binding->chain == chain;
+        }
+        size_t len = std::min(chain.size(), binding->chain.size());
+        return std::equal(chain.begin(), chain.begin() + len,
+                          binding->chain.begin());
+    };
+    auto removeIter = std::remove_if(binds.begin(), binds.end(), matches);
     if (removeIter == binds.end()) {
         return False; // no matching binding found
     }
 
     // Remove binding
-    binds.erase(removeIter);
+    binds.erase(removeIter, binds.end());
     return True;
 }
 
@@ -258,14 +560,14 @@ KeyManager::KeyMask::KeyMask()
 {
 }
 
-bool KeyManager::KeyMask::allowsBinding(const KeyCombo &combo) const
+bool KeyManager::KeyMask::allowsBinding(const KeyBinding& binding) const
 {
     if (regex_.empty()) {
         // an unset keymask allows every binding, regardless of
         // the 'negated_' flag
         return true;
     } else {
-        bool match = regex_.matches(combo.str());
+        bool match = regex_.matches(binding.name);
         if (negated_) {
             // only allow keybindings that don't match
             return !match;
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <X11/Xlib.h>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "attribute_.h"
 #include "commandio.h"
 #include "keycombo.h"
 #include "object.h"
+#include "optional.h"
 #include "regexstr.h"
 #include "xkeygrabber.h"
 
@@ -17,9 +23,28 @@ class Completion;
 /*!
  * Maintains the list of key bindings, and handles the grabbing/ungrabbing with
  * the help of XKeyGrabber
+ *
+ * Every key binding belongs to a mode and consists of a chain of one or
+ * more key combos. The bindings are compiled into a transition table with
+ * one root state per mode and one state per proper prefix of a key chain.
  */
 class KeyManager : public Object {
 private:
+    /*!
+     * Simple container class for tracking a keybinding (only used internally
+     * by KeyManager)
+     */
+    class KeyBinding {
+    public:
+        //! the key combos to be pressed one after another (never empty)
+        std::vector<KeyCombo> chain;
+        //! the mode in which the binding is active
+        std::string mode;
+        //! the chain's combos as strings separated by spaces, computed only once
+        std::string name;
+        std::vector<std::string> cmd;
+    };
+
     /*!
      * Simple parser/container for a keymask regex (only needed internally by
      * KeyManager)
@@ -40,7 +65,7 @@ private:
         KeyMask(const RegexStr& regex, bool negated);
         KeyMask();
 
-        bool allowsBinding(const KeyCombo& combo) const;
+        bool allowsBinding(const KeyBinding& binding) const;
         std::string str() const { return regex_.str(); }
 
         bool operator==(const KeyMask& other) const {
@@ -53,20 +78,40 @@ private:
     };
 
     /*!
-     * Simple container class for tracking a keybinding (only used internally
-     * by KeyManager)
+     * A state in the compiled transition table: either the root state of
+     * a mode or the state after pressing a proper prefix of a key chain.
      */
-    class KeyBinding {
+    class KeyState {
     public:
-        KeyCombo keyCombo;
-        std::vector<std::string> cmd;
-        bool grabbed = false;
+        //! bindings that are completed by pressing the respective combo
+        std::unordered_map<KeyCombo, KeyBinding*, KeyCombo::Hash> bindings;
+        //! states that are entered by pressing the respective combo
+        std::unordered_map<KeyCombo, size_t, KeyCombo::Hash> transitions;
+        //! for root states: all bindings of the mode
+        std::vector<KeyBinding*> modeBindings;
+    };
+
+    /*!
+     * What a pair of keymask and keys_inactive implies for the current
+     * bindings. Both members are filled lazily.
+     */
+    class KeyMaskResults {
+    public:
+        //! whether the keymasks allow the respective binding
+        std::unordered_map<const KeyBinding*, bool> allowed;
+        //! the combos to be grabbed in the respective mode
+        std::map<std::string, XKeyGrabber::KeyComboSet> grabSets;
     };
 
 public:
-    KeyManager() = default;
+    KeyManager();
     ~KeyManager();
 
+    static constexpr auto defaultMode = "default";
+
+    Attribute_<std::string> mode;
+    Attribute_<unsigned long> modeSwitchDuration;
+
     int addKeybindCommand(Input input, Output output);
     int listKeybindsCommand(Output output) const;
     int removeKeybindCommand(Input input, Output output);
@@ -74,7 +119,10 @@ public:
     void addKeybindCompletion(Completion &complete);
     void removeKeybindCompletion(Completion &complete);
 
-    void handleKeyPress(XKeyEvent* ev) const;
+    void handleKeyPress(XKeyEvent* ev);
+    //! the time until a pending key chain is aborted, if there is one
+    std::experimental::optional<std::chrono::microseconds> keyChainTimeout();
+    void leaveChainIfDue();
 
     void regrabAll();
     void ensureKeyMask(const Client* client = nullptr);
@@ -88,14 +136,47 @@ public:
     }
 
 private:
-    bool removeKeyBinding(const KeyCombo& comboToRemove);
-
-    //! Currently defined keybindings
+    static bool parseModeFlag(Input& input, std::string& modeName);
+    static std::vector<KeyCombo> chainFromString(const std::string& str);
+    bool removeKeyBinding(const std::string& modeName,
+                          const std::vector<KeyCombo>& chain,
+                          bool prefixesConflict);
+    bool isAllowed(const KeyBinding& binding);
+    KeyMaskResults& activeResults();
+    void bindingsChanged();
+    std::string isValidMode(std::string modeName);
+    void modeChanged();
+    void compileStates();
+    const XKeyGrabber::KeyComboSet& grabSet(const std::string& modeName);
+    void applyGrabs();
+    void leaveChain();
+
+    //! Currently defined keybindings (in the order of their definition)
     std::vector<std::unique_ptr<KeyBinding>> binds;
 
+    //! The compiled transition table, only valid if statesValid_ is set
+    std::vector<KeyState> states_;
+    //! the index of every mode's root state in states_
+    std::map<std::string, size_t> modeStates_;
+    bool statesValid_ = false;
+    //! the state within a key chain, if a proper prefix of one was pressed
+    size_t chainState_ = 0;
+    bool inChain_ = false;
+    //! when the pending key chain is aborted, if keychain_timeout is set
+    std::experimental::optional<std::chrono::steady_clock::time_point> chainDeadline_;
+
     XKeyGrabber xKeyGrabber_;
 
     // The last applies KeyMask & KeysInactive(for comparison on change)
     KeyMask currentKeyMask_;
     KeyMask currentKeysInactive_;
+    /*!
+     * The results of the recently active keymasks, indexed by the regexes
+     * of the keymask and of keys_inactive. This way, switching the focus
+     * between clients with different keymasks evaluates the regexes only
+     * once. It is cleared whenever the bindings change.
+     */
+    std::map<std::pair<std::string, std::string>, KeyMaskResults> keyMaskResults_;
+    //! the entry of keyMaskResults_ for the active keymasks, if looked up already
+    KeyMaskResults* activeResults_ = nullptr;
 };
@@ -318,8 +318,11 @@ TilingResult FrameLeaf::layoutGrid(Rectangle rect) {
     return res;
 }
 
-TilingResult FrameLeaf::computeLayout(Rectangle rect) {
-    last_rect = rect;
+/**
+ * @brief the geometry of the frame decoration (without its border)
+ * if the frame is laid out in the given rectangle
+ */
+Rectangle FrameLeaf::decorationGeometry(Rectangle rect) {
     if (!settings_->smart_frame_surroundings() || parent_.lock()) {
         // apply frame gap
         rect.height -= settings_->frame_gap();
@@ -333,6 +336,12 @@ TilingResult FrameLeaf::computeLayout(Rectangle rect) {
 
     rect.width = std::max(WINDOW_MIN_WIDTH, rect.width);
     rect.height = std::max(WINDOW_MIN_HEIGHT, rect.height);
+    return rect;
+}
+
+TilingResult FrameLeaf::computeLayout(Rectangle rect) {
+    last_rect = rect;
+    rect = decorationGeometry(rect);
 
     // move windows
     TilingResult res;
@@ -50,6 +50,7 @@ public:
 
     std::shared_ptr<FrameSplit> getParent() { return parent_.lock(); };
     std::shared_ptr<Frame> root();
+    HSTag* getTag() { return tag_; }
     // count the number of splits to the root with alignment "align"
     virtual int splitsToRoot(SplitAlign align);
 
@@ -104,6 +105,7 @@ public:
     void moveClient(int new_index);
 
     TilingResult computeLayout(Rectangle rect) override;
+    Rectangle decorationGeometry(Rectangle rect);
 
     virtual void fmap(std::function<void(FrameSplit*)> onSplit,
                       std::function<void(FrameLeaf*)> onLeaf, int order) override;
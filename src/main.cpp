@@ -184,6 +184,10 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
         {"stack",          { monitors, &MonitorManager::stackCommand }},
         {"dump",           tags->frameCommand(&FrameTree::dumpLayoutCommand, &FrameTree::dumpLayoutCompletion)},
         {"load",           { tags->frameCommand(&FrameTree::loadCommand, &FrameTree::loadCompletion ) }},
+        {"dump_layouts",   { tags, &TagManager::dumpLayoutsCommand }},
+        {"load_layouts",   { tags, &TagManager::loadLayoutsCommand }},
+        {"dump_session",   { global_cmds, &GlobalCommands::dumpSessionCommand }},
+        {"load_session",   { global_cmds, &GlobalCommands::loadSessionCommand }},
         {"complete",       completeCommand},
         {"complete_shell", completeCommand},
         {"lock",           { [monitors] { monitors->lock(); return 0; } }},
@@ -433,7 +437,7 @@ int main(int argc, char* argv[]) {
     }
     root->monitors()->ensure_monitors_are_available();
     mainloop.scanExistingClients();
-    tag_force_update_flags();
+    tag_update_flags();
     all_monitors_apply_layout();
     ewmh->updateAll();
     mainloop.childExited.connect(root->autostart(), &Autostart::childExited);
@@ -527,44 +527,51 @@ int MetaCommands::new_attr_cmd(Input input, Output output)
     if (ap.parsingFails(input, output)) {
         return HERBST_NEED_MORE_ARGS;
     }
-    auto obj_path_and_attr = Object::splitPath(path);
-    string attr_name = obj_path_and_attr.second;
-    Object* obj = root.child(obj_path_and_attr.first, output);
-    if (!obj) {
-        return HERBST_INVALID_ARGUMENT;
+    std::experimental::optional<string> value;
+    if (initialValueSupplied) {
+        value = initialValue;
     }
+    return setUserAttribute(path, type, value, false, output);
+}
+
+//! check that the name of a user attribute has the right prefix
+static bool checkUserAttributeName(const string& attr_name, Output output)
+{
     if (attr_name.substr(0,strlen(USER_ATTRIBUTE_PREFIX)) != USER_ATTRIBUTE_PREFIX) {
         output.perror()
             << "attribute name must start with \""
             << USER_ATTRIBUTE_PREFIX << "\""
             << " but is actually \"" << attr_name << "\"" << endl;
-        return HERBST_INVALID_ARGUMENT;
+        return false;
     }
-    if (obj->attribute(attr_name)) {
+    return true;
+}
+
+//! check that an existing attribute can be overwritten by one of the given type
+static bool checkUserAttributeType(Attribute* a, const string& path,
+                                   const string& type, Output output)
+{
+    if (a->typestr() != type) {
         output.perror()
-            << "object \"" << obj_path_and_attr.first.join()
-            << "\" already has an attribute named \"" << attr_name
-            <<  "\"" << endl;
-        return HERBST_INVALID_ARGUMENT;
+            << "attribute \"" << path << "\" has type "
+            << a->typestr() << " instead of " << type << endl;
+        return false;
     }
-    // create the new attribute and add it
-    Attribute* a = newAttributeWithType(type, attr_name, output);
-    if (!a) {
-        return HERBST_INVALID_ARGUMENT;
-    }
-    obj->addAttribute(a);
-    userAttributes_.push_back(unique_ptr<Attribute>(a));
-    // try to write the attribute
-    if (initialValueSupplied) {
-        string msg = a->change(initialValue);
-        if (!msg.empty()) {
-            output.perror() << "\""
-                   << initialValue << "\" is an invalid "
-                   << "value for " << path << ": " << msg << endl;
-            return HERBST_INVALID_ARGUMENT;
-        }
+    return true;
+}
+
+//! change the value of an attribute and report if the value is invalid
+static bool changeUserAttribute(Attribute* a, const string& path,
+                                const string& value, Output output)
+{
+    string msg = a->change(value);
+    if (!msg.empty()) {
+        output.perror() << "\""
+               << value << "\" is an invalid "
+               << "value for " << path << ": " << msg << endl;
+        return false;
     }
-    return 0;
+    return true;
 }
 
 void MetaCommands::new_attr_complete(Completion& complete)
@@ -622,6 +629,112 @@ void MetaCommands::remove_attr_complete(Completion& complete) {
     }
 }
 
+/**
+ * @brief Every object has several paths in the object tree, e.g. tags.0
+ * and tags.by-name.default. An attribute is reported with the first path
+ * found in a depth-first search that prefers the 'by-name' children, because
+ * names remain stable when objects are added or removed.
+ */
+void MetaCommands::forEachUserAttribute(function<void(const string&, Attribute*)> yield)
+{
+    if (userAttributes_.empty()) {
+        return;
+    }
+    std::unordered_set<Object*> visited;
+    function<void(Object*, const string&)> visit =
+            [&](Object* object, const string& prefix) {
+        if (!visited.insert(object).second) {
+            return;
+        }
+        for (const auto& it : object->attributes()) {
+            if (it.first.substr(0, strlen(USER_ATTRIBUTE_PREFIX)) == USER_ATTRIBUTE_PREFIX) {
+                yield(prefix + it.first, it.second);
+            }
+        }
+        auto children = object->children();
+        vector<pair<string, Object*>> order(children.begin(), children.end());
+        std::stable_partition(order.begin(), order.end(),
+                              [](const pair<string, Object*>& child) {
+            return child.first == "by-name";
+        });
+        for (const auto& child : order) {
+            if (child.first.find(OBJECT_PATH_SEPARATOR) != string::npos) {
+                // such a child can not be addressed by a path
+                continue;
+            }
+            visit(child.second, prefix + child.first + OBJECT_PATH_SEPARATOR);
+        }
+    };
+    visit(&root, "");
+}
+
+/**
+ * @brief Create the user attribute at the given path and write the value
+ * (if given) to it. If 'overwrite' is set, an existing user attribute of
+ * the same type is written instead.
+ * @return the exit code
+ */
+int MetaCommands::setUserAttribute(const string& path, const string& type,
+                                   std::experimental::optional<string> value,
+                                   bool overwrite, Output output)
+{
+    auto obj_path_and_attr = Object::splitPath(path);
+    string attr_name = obj_path_and_attr.second;
+    Object* obj = root.child(obj_path_and_attr.first, output);
+    if (!obj) {
+        return HERBST_INVALID_ARGUMENT;
+    }
+    if (!checkUserAttributeName(attr_name, output)) {
+        return HERBST_INVALID_ARGUMENT;
+    }
+    Attribute* a = obj->attribute(attr_name);
+    if (a && !overwrite) {
+        output.perror()
+            << "object \"" << obj_path_and_attr.first.join()
+            << "\" already has an attribute named \"" << attr_name
+            <<  "\"" << endl;
+        return HERBST_INVALID_ARGUMENT;
+    }
+    if (a && !checkUserAttributeType(a, path, type, output)) {
+        return HERBST_INVALID_ARGUMENT;
+    }
+    if (!a) {
+        // create the new attribute and add it
+        a = newAttributeWithType(type, attr_name, output);
+        if (!a) {
+            return HERBST_INVALID_ARGUMENT;
+        }
+        obj->addAttribute(a);
+        userAttributes_.push_back(unique_ptr<Attribute>(a));
+    }
+    if (value && !changeUserAttribute(a, path, value.value(), output)) {
+        return HERBST_INVALID_ARGUMENT;
+    }
+    return 0;
+}
+
+/**
+ * @brief Check whether setUserAttribute() with 'overwrite' would succeed,
+ * without changing anything. The object is the one the path refers to; it
+ * may be nullptr if it does not exist yet.
+ */
+bool MetaCommands::userAttributeValid(Object* obj, const string& path,
+                                      const string& type, const string& value,
+                                      Output output)
+{
+    string attr_name = Object::splitPath(path).second;
+    if (!checkUserAttributeName(attr_name, output)) {
+        return false;
+    }
+    Attribute* existing = obj ? obj->attribute(attr_name) : nullptr;
+    if (existing && !checkUserAttributeType(existing, path, type, output)) {
+        return false;
+    }
+    // try the value on an attribute of the same type
+    unique_ptr<Attribute> probe(newAttributeWithType(type, attr_name, output));
+    return probe && changeUserAttribute(probe.get(), path, value, output);
+}
+
 template <typename T> int do_comparison(const T& a, const T& b) {
     return (a == b) ? 0 : 1;
 }
@@ -8,6 +8,7 @@
 #include "attribute.h"
 #include "commandio.h"
 #include "converter.h"
+#include "optional.h"
 
 class Object;
 class Completion;
@@ -61,6 +62,14 @@ public:
     void new_attr_complete(Completion& complete);
     int remove_attr_cmd(Input input, Output output);
     void remove_attr_complete(Completion& complete);
+    //! call yield for every user attribute and its path in the object tree
+    void forEachUserAttribute(std::function<void(const std::string&, Attribute*)> yield);
+    int setUserAttribute(const std::string& path, const std::string& type,
+                         std::experimental::optional<std::string> value,
+                         bool overwrite, Output output);
+    bool userAttributeValid(Object* obj, const std::string& path,
+                            const std::string& type, const std::string& value,
+                            Output output);
     int compare_cmd(Input input, Output output);
     void compare_complete(Completion& complete);
     static Attribute* newAttributeWithType(std::string typestr, std::string attr_name, Output output);
@@ -49,6 +49,7 @@ Monitor::Monitor(Settings* settings_, MonitorManager* monman_, Rectangle rect_,
     , lock_frames(false)
     , mouse { 0, 0 }
     , rect(this, "geometry", rect_, &Monitor::atLeastMinWindowSize)
+    , restackCount_(this, "restack_count", 0)
     , settings(settings_)
     , monman(monman_)
 {
@@ -80,6 +81,10 @@ Monitor::Monitor(Settings* settings_, MonitorManager* monman_, Rectangle rect_,
     pad_left.setDoc("space for panels at the monitor\'s left edge");
     lock_tag.setDoc("if activated, then it it is not possible to switch "
                     "this monitor to a different tag.");
+    restackCount_.setDoc("the number of times the stacking order of "
+                         "the windows on this monitor was sent to the "
+                         "X server. Restacks that would not change the "
+                         "order are skipped.");
 }
 
 Monitor::~Monitor() {
@@ -221,7 +226,7 @@ void Monitor::applyLayout() {
             }
         }
     }
-    tag->stack->clearLayer(LAYER_FOCUS);
+    Slice* focusLayerSlice = nullptr;
     if (res.focus) {
         // activate the focus layer if requested by the setting
         // or if there is a fullscreen client potentially covering
@@ -229,7 +234,19 @@ void Monitor::applyLayout() {
         if ((isFocused && g_settings->raise_on_focus_temporarily())
             || tag->stack->isLayerEmpty(LAYER_FULLSCREEN) == false)
         {
-            tag->stack->sliceAddLayer(res.focus->slice, LAYER_FOCUS);
+            focusLayerSlice = res.focus->slice;
+        }
+    }
+    // only modify the focus layer if its content changes, such that
+    // the stack does not become dirty needlessly
+    const auto& focusLayer = tag->stack->layers_[LAYER_FOCUS];
+    bool focusLayerUpToDate = focusLayerSlice
+        ? (focusLayer.size() == 1 && *focusLayer.begin() == focusLayerSlice)
+        : focusLayer.empty();
+    if (!focusLayerUpToDate) {
+        tag->stack->clearLayer(LAYER_FOCUS);
+        if (focusLayerSlice) {
+            tag->stack->sliceAddLayer(focusLayerSlice, LAYER_FOCUS);
         }
     }
     restack();
@@ -365,12 +382,7 @@ void Monitor::renameComplete(Completion& complete)
 }
 
 Monitor* find_monitor_with_tag(HSTag* tag) {
-    for (auto m : *g_monitors) {
-        if (m->tag == tag) {
-            return m;
-        }
-    }
-    return nullptr;
+    return g_monitors->byTag(tag);
 }
 
 Monitor* get_current_monitor() {
@@ -383,7 +395,12 @@ void all_monitors_apply_layout() {
     }
 }
 
-int monitor_set_tag(Monitor* monitor, HSTag* tag) {
+/**
+ * @brief Show the tag on the monitor. If another monitor shows the tag
+ * already, then the two monitors swap their tags if forceSwap is set or
+ * if the setting swap_monitors_to_get_tag is activated.
+ */
+int monitor_set_tag(Monitor* monitor, HSTag* tag, bool forceSwap) {
     Monitor* other = find_monitor_with_tag(tag);
     if (monitor == other) {
         // nothing to do
@@ -400,7 +417,7 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
         return 1;
     }
     if (other) {
-        if (g_settings->swap_monitors_to_get_tag()) {
+        if (forceSwap || g_settings->swap_monitors_to_get_tag()) {
             if (other->lock_tag) {
                 // the monitor we want to steal the tag from is
                 // locked. focus that monitor instead
@@ -410,8 +427,8 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
             monitor->tag_previous = monitor->tag;
             other->tag_previous = other->tag;
             // swap tags
-            other->tag = monitor->tag;
-            monitor->tag = tag;
+            g_monitors->assignTag(other, monitor->tag);
+            g_monitors->assignTag(monitor, tag);
             /* TODO: find the best order of restacking and layouting */
             other->restack();
             monitor->restack();
@@ -420,7 +437,7 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
             monitor_update_focus_objects();
             Ewmh::get().updateCurrentDesktop();
             emit_tag_changed(other->tag, other->index());
-            emit_tag_changed(tag, g_monitors->cur_monitor);
+            emit_tag_changed(tag, monitor->index());
         } else {
             // if we are not allowed to steal the tag, then just focus the
             // other monitor
@@ -432,7 +449,7 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
     // save old tag
     monitor->tag_previous = old_tag;
     // 1. show new tag
-    monitor->tag = tag;
+    g_monitors->assignTag(monitor, tag);
     // first reset focus and arrange windows
     monitor->restack();
     monitor->lock_frames = true;
@@ -450,7 +467,7 @@ int monitor_set_tag(Monitor* monitor, HSTag* tag) {
     g_monitors->dropEnterNotifyEvents.emit();
     monitor_update_focus_objects();
     Ewmh::get().updateCurrentDesktop();
-    emit_tag_changed(tag, g_monitors->cur_monitor);
+    emit_tag_changed(tag, monitor->index());
     return 0;
 }
 
@@ -545,6 +562,16 @@ void Monitor::restack() {
             fullscreenFocus = client->x11Window();
         }
         XRaiseWindow(g_display, fullscreenFocus);
+        monman->invalidateRestack();
+    }
+    bool restackAll = lastRestackTag_ != tag
+        || lastRestackRemovals_ != tag->stack->removalCount()
+        || lastRestack_.empty();
+    if (!restackAll && !tag->stack->isDirty()
+        && fullscreenFocus == lastFullscreenFocus_)
+    {
+        // the windows are already stacked correctly
+        return;
     }
     // collect all other windows in a vector and pass it to XRestackWindows
     vector<Window> buf = { stacking_window };
@@ -554,7 +581,36 @@ void Monitor::restack() {
         }
     };
     tag->stack->extractWindows(false, addToVector);
-    XRestackWindows(g_display, buf.data(), buf.size());
+    tag->stack->markClean();
+    if (restackAll) {
+        XRestackWindows(g_display, buf.data(), buf.size());
+        restackCount_ = restackCount_() + 1;
+    } else {
+        // only the windows of this monitor's tag were restacked since the
+        // last time, so it suffices to move those whose relative order changed
+        auto operations = Stack::restackOperations(lastRestack_, buf);
+        for (const auto& op : operations) {
+            XWindowChanges changes;
+            changes.sibling = op.second;
+            changes.stack_mode = Below;
+            XConfigureWindow(g_display, op.first, CWSibling | CWStackMode, &changes);
+        }
+        if (!operations.empty()) {
+            restackCount_ = restackCount_() + 1;
+        }
+    }
+    lastRestack_.swap(buf);
+    lastFullscreenFocus_ = fullscreenFocus;
+    // the order of the windows on the entire screen may have changed
+    monman->invalidateRestack();
+    lastRestackTag_ = tag;
+    lastRestackRemovals_ = tag->stack->removalCount();
+}
+
+void Monitor::invalidateRestack()
+{
+    lastRestack_.clear();
+    lastRestackTag_ = nullptr;
 }
 
 Rectangle Monitor::getFloatingArea() const {
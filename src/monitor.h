@@ -2,6 +2,7 @@
 #define __HERBSTLUFT_MONITOR_H_
 
 #include <X11/X.h>
+#include <vector>
 
 #include "attribute_.h"
 #include "object.h"
@@ -42,6 +43,7 @@ public:
     } mouse;
     Attribute_<Rectangle>   rect;   // area for this monitor
     Window      stacking_window;   // window used for making stacking easy
+    Attribute_<unsigned long> restackCount_;
     Signal monitorMoved;
     void setIndexAttribute(unsigned long index) override;
     int lock_tag_cmd(Input argv, Output output);
@@ -55,6 +57,8 @@ public:
     bool setTag(HSTag* new_tag);
     void applyLayout();
     void restack();
+    //! forget the stacking order established by the last restack()
+    void invalidateRestack();
     std::string getDescription();
     void evaluateClientPlacement(Client* client, ClientPlacement placement) const;
     static std::string atLeastMinWindowSize(Rectangle geom);
@@ -63,6 +67,13 @@ private:
     std::string setTagString(std::string new_tag);
     Settings* settings;
     MonitorManager* monman;
+    //! the windows passed to the X server in the last restack()
+    std::vector<Window> lastRestack_;
+    //! the tag and its stack's removalCount() during the last restack()
+    HSTag* lastRestackTag_ = nullptr;
+    unsigned long lastRestackRemovals_ = 0;
+    //! the focused fullscreen window that was raised in the last restack()
+    Window lastFullscreenFocus_ = 0;
 };
 
 // adds a new monitor to the monitors list and returns a pointer to it
@@ -71,7 +82,7 @@ void monitor_focus_by_index(unsigned new_selection);
 Monitor* find_monitor_by_name(const char* name);
 Monitor* string_to_monitor(const char* string);
 Monitor* get_current_monitor();
-int monitor_set_tag(Monitor* monitor, HSTag* tag);
+int monitor_set_tag(Monitor* monitor, HSTag* tag, bool forceSwap = false);
 void all_monitors_apply_layout();
 void ensure_monitors_are_available();
 
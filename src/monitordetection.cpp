@@ -86,3 +86,32 @@ vector<MonitorDetection> MonitorDetection::detectors() {
     return { xrandr, xinerama };
 }
 
+
+int MonitorDetection::selectRandrEvents(XConnection& X) {
+    int event_base = 0;
+    int error_base = 0;
+    if (!XRRQueryExtension(X.display(), &event_base, &error_base)) {
+        return -1;
+    }
+    int major_version = 0, minor_version = 0;
+    XRRQueryVersion(X.display(), &major_version, &minor_version);
+    int mask = RRScreenChangeNotifyMask;
+    if (make_pair(major_version, minor_version) >= make_pair(1, 2)) {
+        // outputs and crtcs were introduced with randr 1.2
+        mask |= RROutputChangeNotifyMask | RRCrtcChangeNotifyMask;
+    }
+    XRRSelectInput(X.display(), X.root(), mask);
+    return event_base;
+}
+
+bool MonitorDetection::isRandrChange(int randrEventBase, XEvent* event) {
+    if (randrEventBase < 0) {
+        return false;
+    }
+    if (event->type == randrEventBase + RRScreenChangeNotify) {
+        // let Xlib know about the new screen size
+        XRRUpdateConfiguration(event);
+        return true;
+    }
+    return event->type == randrEventBase + RRNotify;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <X11/Xlib.h>
 #include <string>
 #include <vector>
 
@@ -17,5 +18,13 @@ public:
     RectangleVec (*detect_)(XConnection& X);
 
     static std::vector<MonitorDetection> detectors();
+
+    /** subscribe to the RandR events announcing a change of the monitor
+     * configuration. Returns the RandR event base or -1 if RandR is not
+     * available.
+     */
+    static int selectRandrEvents(XConnection& X);
+    //! whether the event is a RandR event announcing a monitor change
+    static bool isRandrChange(int randrEventBase, XEvent* event);
 };
 
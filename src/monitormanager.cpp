@@ -2,7 +2,9 @@
 
 #include <X11/Xlib.h>
 #include <cassert>
+#include <iostream>
 #include <memory>
+#include <sstream>
 
 #include "argparse.h"
 #include "command.h"
@@ -12,6 +14,7 @@
 #include "floating.h"
 #include "frametree.h"
 #include "globals.h"
+#include "layout.h"
 #include "ipc-protocol.h"
 #include "monitor.h"
 #include "monitordetection.h"
@@ -34,6 +37,10 @@ using std::shared_ptr;
 using std::string;
 using std::to_string;
 using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
 
 template<>
 RunTimeConverter<Monitor*>* Converter<Monitor*>::converter = nullptr;
@@ -72,6 +79,7 @@ void MonitorManager::injectDependencies(Settings* s, TagManager* t, PanelManager
 
 void MonitorManager::clearChildren() {
     IndexingObject<Monitor>::clearChildren();
+    monitorByTag_.clear();
     focus = {};
     tags_ = {};
 }
@@ -274,12 +282,24 @@ CommandBinding MonitorManager::tagCommand(TagCallOrComplete cmd)
 
 
 Monitor* MonitorManager::byTag(HSTag* tag) {
-    for (Monitor* m : *this) {
-        if (m->tag == tag) {
-            return m;
-        }
+    auto it = monitorByTag_.find(tag);
+    if (it == monitorByTag_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void MonitorManager::assignTag(Monitor* monitor, HSTag* tag)
+{
+    auto it = monitorByTag_.find(monitor->tag);
+    // when swapping tags, the old tag may already belong to another monitor
+    if (it != monitorByTag_.end() && it->second == monitor) {
+        monitorByTag_.erase(it);
+    }
+    monitor->tag = tag;
+    if (tag) {
+        monitorByTag_[tag] = monitor;
     }
-    return nullptr;
 }
 
 /**
@@ -302,12 +322,8 @@ Monitor* MonitorManager::byCoordinate(Point2D p)
 
 Monitor* MonitorManager::byFrame(shared_ptr<Frame> frame)
 {
-    for (Monitor* m : *this) {
-        if (m->tag->frame->contains(frame)) {
-            return m;
-        }
-    }
-    return nullptr;
+    // every frame knows the tag it belongs to
+    return byTag(frame->getTag());
 }
 
 void MonitorManager::relayoutTag(HSTag* tag)
@@ -356,6 +372,7 @@ void MonitorManager::removeMonitor(Monitor* monitor)
     monitor->tag->setVisible(false);
 
     monitorStack_.remove(monitor);
+    monitorByTag_.erase(monitor->tag);
     g_monitors->removeIndexed(monitorIdx);
 
     if (cur_monitor >= static_cast<int>(g_monitors->size())) {
@@ -436,41 +453,59 @@ string MonitorManager::isValidMonitorName(string name) {
 void MonitorManager::autoUpdatePads()
 {
     for (Monitor* m : *this) {
-        PanelManager::ReservedSpace rs = panels_->computeReservedSpace(m->rect);
-        // all the sides in the order as it matters for pad_automatically_set
-        vector<pair<Attribute_<int>&, int>> sides = {
-            { m->pad_up,    rs.top_     },
-            { m->pad_right, rs.right_   },
-            { m->pad_down,  rs.bottom_  },
-            { m->pad_left,  rs.left_    },
-        };
-        size_t idx = 0;
-        for (auto& it : sides ) {
-            if (it.first() != it.second) {
-                if (it.second != 0) {
-                    // if some panel was added or resized
-                    it.first.operator=(it.second);
-                    m->pad_automatically_set[idx] = true;
-                } else {
-                    // if there is no panel, then only clear the pad
-                    // if the pad was added by us before
-                    if (m->pad_automatically_set[idx]) {
-                        it.first.operator=(0);
-                        m->pad_automatically_set[idx] = false;
-                    }
+        autoUpdatePads(m);
+    }
+}
+
+void MonitorManager::autoUpdatePadsIn(RectangleVec areas)
+{
+    for (Monitor* m : *this) {
+        for (const auto& area : areas) {
+            if (m->rect->intersectionWith(area)) {
+                autoUpdatePads(m);
+                break;
+            }
+        }
+    }
+}
+
+void MonitorManager::autoUpdatePads(Monitor* m)
+{
+    PanelManager::ReservedSpace rs = panels_->computeReservedSpace(m->rect);
+    // all the sides in the order as it matters for pad_automatically_set
+    vector<pair<Attribute_<int>&, int>> sides = {
+        { m->pad_up,    rs.top_     },
+        { m->pad_right, rs.right_   },
+        { m->pad_down,  rs.bottom_  },
+        { m->pad_left,  rs.left_    },
+    };
+    size_t idx = 0;
+    for (auto& it : sides ) {
+        if (it.first() != it.second) {
+            if (it.second != 0) {
+                // if some panel was added or resized
+                it.first.operator=(it.second);
+                m->pad_automatically_set[idx] = true;
+            } else {
+                // if there is no panel, then only clear the pad
+                // if the pad was added by us before
+                if (m->pad_automatically_set[idx]) {
+                    it.first.operator=(0);
+                    m->pad_automatically_set[idx] = false;
                 }
             }
-            idx++;
         }
+        idx++;
     }
 }
 
 Monitor* MonitorManager::addMonitor(Rectangle rect, HSTag* tag) {
     Monitor* m = new Monitor(settings_, this, rect, tag);
     addIndexed(m);
+    monitorByTag_[tag] = m;
     monitorStack_.insert(m);
-    m->monitorMoved.connect([this]() {
-        this->autoUpdatePads();
+    m->monitorMoved.connect([this,m]() {
+        this->autoUpdatePads(m);
     });
     return m;
 }
@@ -517,7 +552,13 @@ void MonitorManager::restack() {
     DesktopWindow::foreachDesktopWindow([&buf](DesktopWindow& dw) {
         buf.push_back(dw.window());
     });
-    XRestackWindows(g_display, buf.data(), buf.size());
+    if (buf != lastRestack_) {
+        XRestackWindows(g_display, buf.data(), buf.size());
+        for (Monitor* m : *this) {
+            m->invalidateRestack();
+        }
+        lastRestack_.swap(buf);
+    }
     Ewmh::get().updateClientListStacking();
 }
 
@@ -552,7 +593,7 @@ int MonitorManager::stackCommand(Output output) {
     for (Monitor* monitor : monitorStack_) {
         vector<shared_ptr<StringTree>> layers;
         for (size_t layerIdx = 0; layerIdx < LAYER_COUNT; layerIdx++) {
-            auto layer = monitor->tag->stack->layers_[layerIdx];
+            const auto& layer = monitor->tag->stack->layers_[layerIdx];
 
             vector<shared_ptr<StringTree>> slices;
             for (auto& slice : layer) {
@@ -588,13 +629,16 @@ int MonitorManager::setMonitors(const RectangleVec& templates) {
         return HERBST_INVALID_ARGUMENT;
     }
     HSTag* tag = nullptr;
+    // only the monitors whose geometry changed need a new layout
+    vector<Monitor*> changed;
     unsigned i;
     for (i = 0; i < std::min(templates.size(), size()); i++) {
         auto m = byIdx(i);
-        if (!m) {
+        if (!m || m->rect() == templates[i]) {
             continue;
         }
         m->rect = templates[i];
+        changed.push_back(m);
     }
     // add additional monitors
     for (; i < templates.size(); i++) {
@@ -602,16 +646,23 @@ int MonitorManager::setMonitors(const RectangleVec& templates) {
         if (!tag) {
             return HERBST_TAG_IN_USE;
         }
-        addMonitor(templates[i], tag);
+        Monitor* m = addMonitor(templates[i], tag);
         tag->setVisible(true);
+        changed.push_back(m);
     }
+    bool removed = i < size();
     // remove monitors if there are too much
     while (i < size()) {
         removeMonitor(byIdx(i));
     }
+    if (changed.empty() && !removed) {
+        return 0;
+    }
     monitor_update_focus_objects();
     autoUpdatePads();
-    all_monitors_apply_layout();
+    for (Monitor* m : changed) {
+        m->applyLayout();
+    }
     return 0;
 }
 
@@ -777,6 +828,45 @@ int MonitorManager::detectMonitorsCommand(Input input, Output output)
 }
 
 
+/** Monitor changes often come in bursts, e.g. when a docking station
+ * enables several outputs one after another. So the detection is delayed
+ * until no further change happened for auto_detect_monitors_delay.
+ */
+void MonitorManager::scheduleMonitorDetection()
+{
+    monitorDetectionDue_ = steady_clock::now()
+        + milliseconds(settings_->auto_detect_monitors_delay());
+}
+
+std::experimental::optional<microseconds> MonitorManager::monitorDetectionTimeout()
+{
+    if (!monitorDetectionDue_) {
+        return {};
+    }
+    auto now = steady_clock::now();
+    if (*monitorDetectionDue_ <= now) {
+        return microseconds(0);
+    }
+    return duration_cast<microseconds>(*monitorDetectionDue_ - now);
+}
+
+void MonitorManager::detectMonitorsIfDue()
+{
+    auto timeout = monitorDetectionTimeout();
+    if (!timeout || timeout->count() > 0) {
+        return;
+    }
+    monitorDetectionDue_ = {};
+    if (!settings_->auto_detect_monitors()) {
+        return;
+    }
+    Input input = Input("detect_monitors");
+    std::ostringstream void_output;
+    // discard output, but forward errors to std:cerr
+    OutputChannels channels("", void_output, std::cerr);
+    detectMonitorsCommand(input, channels);
+}
+
 /**
  * @brief The type 'int' extended by an 'undefined' value represented by
  * the empty string.
@@ -886,8 +976,9 @@ int MonitorManager::raiseMonitorCommand(Input input, Output output) {
         output.perror() << "Monitor \"" << monitorName << "\" not found!\n";
         return HERBST_INVALID_ARGUMENT;
     }
-    monitorStack_.raise(monitor);
-    restack();
+    if (monitorStack_.raise(monitor)) {
+        restack();
+    }
     return 0;
 }
 
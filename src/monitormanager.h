@@ -1,8 +1,10 @@
 #ifndef __HERBSTLUFT_MONITOR_MANAGER_H_
 #define __HERBSTLUFT_MONITOR_MANAGER_H_
 
+#include <chrono>
 #include <functional>
 #include <string>
+#include <unordered_map>
 
 #include "byname.h"
 #include "commandio.h"
@@ -45,6 +47,8 @@ public:
     Monitor* byTag(HSTag* tag);
     Monitor* byCoordinate(Point2D p);
     Monitor* byFrame(std::shared_ptr<Frame> frame);
+    //! set the tag shown on the monitor and update the tag-to-monitor index
+    void assignTag(Monitor* monitor, HSTag* tag);
 
     // RunTimeConverter<Monitor*>:
     virtual Monitor* parse(const std::string& str) override;
@@ -72,6 +76,8 @@ public:
     std::string isValidMonitorName(std::string name);
 
     void autoUpdatePads();
+    //! update the pads of the monitors intersecting one of the areas
+    void autoUpdatePadsIn(RectangleVec areas);
 
     int indexInDirection(Monitor* relativeTo, Direction dir);
 
@@ -82,6 +88,8 @@ public:
     int stackCommand(Output output);
     void extractWindowStack(bool real_clients, std::function<void(Window)> yield);
     void restack();
+    //! forget the stacking order established by the last restack()
+    void invalidateRestack() { lastRestack_.clear(); }
     int raiseMonitorCommand(Input input, Output output);
     void raiseMonitorCompletion(Completion& complete);
 
@@ -91,6 +99,11 @@ public:
 
     int detectMonitorsCommand(Input input, Output output);
     void detectMonitorsCompletion(Completion& complete);
+    //! run detect_monitors once the monitor configuration has settled
+    void scheduleMonitorDetection();
+    //! the time until the scheduled monitor detection is due
+    std::experimental::optional<std::chrono::microseconds> monitorDetectionTimeout();
+    void detectMonitorsIfDue();
 
     void focusCommand(CallOrComplete invoc);
     void cycleCommand(CallOrComplete invoc);
@@ -113,8 +126,14 @@ public:
 
 private:
     std::function<int(Input, Output)> byFirstArg(MonitorCommand cmd);
+    void autoUpdatePads(Monitor* m);
 
     PlainStack<Monitor*> monitorStack_;
+    //! the monitor showing a tag, for every visible tag
+    std::unordered_map<HSTag*, Monitor*> monitorByTag_;
+    //! the windows passed to XRestackWindows in the last restack()
+    std::vector<Window> lastRestack_;
+    std::experimental::optional<std::chrono::steady_clock::time_point> monitorDetectionDue_;
 
     ByName by_name_;
     PanelManager* panels_;
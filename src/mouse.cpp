@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "client.h"
+#include "clientedgeindex.h"
 #include "completion.h"
 #include "decoration.h"
 #include "monitor.h"
@@ -168,8 +169,31 @@ void client_snap_vector(Client* client, Monitor* monitor,
         snap_1d(d.rect.y + d.rect.height, m->rect->y + m->rect->height - m->pad_down - g_settings->snap_gap(), &d.dy);
     }
 
-    // snap to other clients
-    tag->foreachClient([&d] (Client* c) { client_snap_helper(c, &d); });
+    // snap to other clients. Only those clients need to be considered
+    // that have an edge within the snap distance of the according edge
+    int gap = g_settings->snap_gap();
+    auto snapHelper = [&d] (Client* c, Rectangle) {
+        client_snap_helper(c, &d);
+        return true;
+    };
+    const ClientEdgeIndex& index = *tag->edgeIndex;
+    using Key = ClientEdgeIndex::Key;
+    if (flags & SNAP_EDGE_RIGHT) {
+        int edge = d.rect.x + d.rect.width + gap;
+        index.foreachBetween(Key::Left, edge - distance, edge + distance, snapHelper);
+    }
+    if (flags & SNAP_EDGE_LEFT) {
+        int edge = d.rect.x - gap;
+        index.foreachBetween(Key::Right, edge - distance, edge + distance, snapHelper);
+    }
+    if (flags & SNAP_EDGE_TOP) {
+        int edge = d.rect.y - gap;
+        index.foreachBetween(Key::Bottom, edge - distance, edge + distance, snapHelper);
+    }
+    if (flags & SNAP_EDGE_BOTTOM) {
+        int edge = d.rect.y + d.rect.height + gap;
+        index.foreachBetween(Key::Top, edge - distance, edge + distance, snapHelper);
+    }
 
     // write back results
     if (abs(d.dx) < abs(distance)) {
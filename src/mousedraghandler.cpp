@@ -1,17 +1,66 @@
 #include "mousedraghandler.h"
 
+#include <X11/Xlib.h>
+#include <algorithm>
+
 #include "client.h"
 #include "decoration.h"
 #include "framedata.h"
+#include "framedecoration.h"
 #include "layout.h"
 #include "monitormanager.h"
 #include "mouse.h"
+#include "settings.h"
+#include "utils.h"
 #include "x11-utils.h"
+#include "xconnection.h"
 
 using std::make_shared;
 using std::shared_ptr;
 using std::weak_ptr;
 
+DragOutline::DragOutline(Settings* settings)
+    : settings_(settings)
+    , borderWidth_(std::max(1, settings->frame_border_width()))
+{
+    window_ = FrameDecoration::createWindow(borderWidth_, NoEventMask);
+}
+
+DragOutline::~DragOutline()
+{
+    XDestroyWindow(XConnection::get().display(), window_);
+}
+
+//! show the outline such that its outer edges are the given geometry
+void DragOutline::show(Rectangle geometry)
+{
+    if (mapped_ && geometry == geometry_) {
+        return;
+    }
+    XConnection& xcon = XConnection::get();
+    int width = std::max(1, geometry.width - 2 * borderWidth_);
+    int height = std::max(1, geometry.height - 2 * borderWidth_);
+    if (!mapped_ || geometry.width != geometry_.width
+        || geometry.height != geometry_.height) {
+        // only the border is visible
+        window_cut_rect_holes(xcon, window_, width, height,
+                              { Rectangle(0, 0, width, height) });
+    }
+    XMoveResizeWindow(xcon.display(), window_,
+                      geometry.x, geometry.y, width, height);
+    if (!mapped_ || geometry.width != geometry_.width
+        || geometry.height != geometry_.height) {
+        // the inner border pattern depends on the window size
+        FrameDecoration::setBorderColor(settings_, window_,
+                settings_->frame_border_active_color->toX11Pixel());
+    }
+    if (!mapped_) {
+        XMapRaised(xcon.display(), window_);
+        mapped_ = true;
+    }
+    geometry_ = geometry;
+}
+
 MouseDragHandlerFloating::MouseDragHandlerFloating(MonitorManager* monitors, Client* dragClient, DragFunction function)
   : monitors_(monitors)
   , winDragClient_(dragClient)
@@ -24,6 +73,9 @@ MouseDragHandlerFloating::MouseDragHandlerFloating(MonitorManager* monitors, Cli
         dragMonitorIndex_ = dragMonitor_->index();
     }
     assertDraggingStillSafe();
+    if (g_settings->drag_outline()) {
+        outline_ = make_unique<DragOutline>(g_settings);
+    }
 }
 
 void MouseDragHandlerFloating::handle_motion_event(Point2D newCursorPos)
@@ -55,10 +107,21 @@ void MouseDragHandlerFloating::assertDraggingStillSafe() {
  * This relayouts the monitor on which the drag happend
  */
 void MouseDragHandlerFloating::finalize() {
+    outline_.reset();
     assertDraggingStillSafe();
     dragMonitor_->applyLayout();
 }
 
+//! show the client at its new floating geometry, or only its outline
+void MouseDragHandlerFloating::applyGeometry() {
+    if (outline_) {
+        Rectangle geometry = winDragClient_->floatingGeometryOnMonitor(dragMonitor_);
+        outline_->show(winDragClient_->dec->inner_to_outer(geometry));
+    } else {
+        winDragClient_->resize_floating(dragMonitor_, get_current_client() == winDragClient_);
+    }
+}
+
 void MouseDragHandlerFloating::mouse_function_move(Point2D newCursorPos) {
     int x_diff = newCursorPos.x - buttonDragStart_.x;
     int y_diff = newCursorPos.y - buttonDragStart_.y;
@@ -69,7 +132,7 @@ void MouseDragHandlerFloating::mouse_function_move(Point2D newCursorPos) {
     client_snap_vector(winDragClient_, dragMonitor_,
                        SNAP_EDGE_ALL, &dx, &dy);
     winDragClient_->float_size_ = winDragClient_->float_size_->shifted({dx, dy});
-    winDragClient_->resize_floating(dragMonitor_, get_current_client() == winDragClient_);
+    applyGeometry();
 }
 
 void MouseDragHandlerFloating::mouse_function_resize(Point2D newCursorPos) {
@@ -158,7 +221,7 @@ void MouseDragHandlerFloating::mouse_function_resize(Point2D newCursorPos) {
             - new_geometry.height;
     }
     winDragClient_->float_size_ = new_geometry;
-    winDragClient_->resize_floating(dragMonitor_, get_current_client() == winDragClient_);
+    applyGeometry();
 }
 
 void MouseDragHandlerFloating::mouse_function_zoom(Point2D newCursorPos) {
@@ -211,13 +274,14 @@ void MouseDragHandlerFloating::mouse_function_zoom(Point2D newCursorPos) {
                                     cent_y - new_height / 2,
                                     new_width,
                                     new_height);
-    winDragClient_->resize_floating(dragMonitor_, get_current_client() == winDragClient_);
+    applyGeometry();
 }
 
 MouseResizeFrame::MouseResizeFrame(MonitorManager *monitors, shared_ptr<FrameLeaf> frame,
                      weak_ptr<FrameSplit> splitX,
                      weak_ptr<FrameSplit> splitY)
     : monitors_(monitors)
+    , dragFrame_(frame)
     , dragFrameX_(splitX)
     , dragFrameY_(splitY)
 {
@@ -228,6 +292,7 @@ MouseResizeFrame::MouseResizeFrame(MonitorManager *monitors, shared_ptr<FrameLea
         throw DragNotPossible("Frame not on any monitor");
     }
     buttonDragStart_ = get_cursor_position();
+    frameDragStart_ = frame->lastRect();
     auto dfX = dragFrameX_.lock();
     if (dfX != nullptr) {
         dragDistanceUnitX_ = dfX->lastRect().width;
@@ -241,10 +306,14 @@ MouseResizeFrame::MouseResizeFrame(MonitorManager *monitors, shared_ptr<FrameLea
     if (!dfX && !dfY) {
         throw DragNotPossible("No neighbour frame");
     }
+    if (g_settings->drag_outline()) {
+        outline_ = make_unique<DragOutline>(g_settings);
+    }
 }
 
 void MouseResizeFrame::finalize()
 {
+    outline_.reset();
     assertDraggingStillSafe();
     dragMonitor_->applyLayout();
 }
@@ -265,7 +334,49 @@ void MouseResizeFrame::handle_motion_event(Point2D newCursorPos)
         int delta = (deltaVec.y * dragStartFractionY_.unit_) / dragDistanceUnitY_;
         dfY->setFraction(dragStartFractionY_ + FixPrecDec::raw(delta));
     }
-    dragMonitor_->applyLayout();
+    if (!outline_) {
+        dragMonitor_->applyLayout();
+        return;
+    }
+    // only show where the frame's edges will be. For this, translate the
+    // change of the fractions back to pixels. The frame's edge at a split
+    // moves, depending on which side of the split the frame is.
+    Rectangle geometry = frameDragStart_;
+    if (dfX) {
+        Rectangle splitRect = dfX->lastRect();
+        int splitPos = splitRect.x
+            + (splitRect.width * dragStartFractionX_.value_) / FixPrecDec::unit_;
+        int delta = ((dfX->getFraction() - dragStartFractionX_).value_
+                     * dragDistanceUnitX_) / FixPrecDec::unit_;
+        if (geometry.x + geometry.width / 2 < splitPos) {
+            geometry.width += delta;
+        } else {
+            geometry.x += delta;
+            geometry.width -= delta;
+        }
+    }
+    if (dfY) {
+        Rectangle splitRect = dfY->lastRect();
+        int splitPos = splitRect.y
+            + (splitRect.height * dragStartFractionY_.value_) / FixPrecDec::unit_;
+        int delta = ((dfY->getFraction() - dragStartFractionY_).value_
+                     * dragDistanceUnitY_) / FixPrecDec::unit_;
+        if (geometry.y + geometry.height / 2 < splitPos) {
+            geometry.height += delta;
+        } else {
+            geometry.y += delta;
+            geometry.height -= delta;
+        }
+    }
+    // the frame decoration is placed within this geometry the same way
+    // as the frame layout does it, so the outline matches the final frame
+    auto frame = dragFrame_.lock();
+    if (frame) {
+        geometry = frame->decorationGeometry(geometry)
+                   .adjusted(g_settings->frame_border_width(),
+                             g_settings->frame_border_width());
+    }
+    outline_->show(geometry);
 }
 
 MouseDragHandler::Constructor MouseResizeFrame::construct(shared_ptr<FrameLeaf> frame, const ResizeAction& resize)
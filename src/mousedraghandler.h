@@ -1,5 +1,6 @@
 #pragma once
 
+#include <X11/X.h>
 #include <functional>
 #include <memory>
 
@@ -14,6 +15,25 @@ class HSTag;
 class Monitor;
 class MonitorManager;
 class ResizeAction;
+class Settings;
+
+/**
+ * @brief The DragOutline is a window that only consists of a border.
+ * It indicates the geometry of the dragged window or frame if the
+ * setting 'drag_outline' is activated.
+ */
+class DragOutline {
+public:
+    explicit DragOutline(Settings* settings);
+    ~DragOutline();
+    void show(Rectangle geometry);
+private:
+    Settings* settings_;
+    Window window_;
+    int borderWidth_;
+    bool mapped_ = false;
+    Rectangle geometry_;
+};
 
 /**
  * @brief The abstract class MouseDragHandler encapsulates what drag handling
@@ -70,8 +90,10 @@ public:
     bool lockHeight = false; // when resizing, do not modify the height
 private:
     void assertDraggingStillSafe();
+    void applyGeometry();
 
     MonitorManager*  monitors_;
+    std::unique_ptr<DragOutline> outline_; //! only set in outline mode
     Point2D          buttonDragStart_ = {};
     Rectangle        winDragStart_;
     Client*        winDragClient_ = nullptr;
@@ -99,6 +121,9 @@ private:
     void assertDraggingStillSafe();
 
     MonitorManager*  monitors_;
+    std::unique_ptr<DragOutline> outline_; //! only set in outline mode
+    std::weak_ptr<FrameLeaf> dragFrame_; //! the frame whose edges are dragged
+    Rectangle        frameDragStart_; //! the geometry of the frame initially
     Point2D          buttonDragStart_ = {};
     std::weak_ptr<FrameSplit> dragFrameX_; //! the frame whose split is adjusted in x direction
     FixPrecDec       dragStartFractionX_ = FixPrecDec::fromInteger(0); //! initial fraction
@@ -21,9 +21,13 @@
 #include "mouse.h"
 #include "mousedraghandler.h"
 #include "root.h"
+#include "settings.h"
 #include "tag.h"
 #include "x11-utils.h"
 
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
 using std::make_shared;
 using std::vector;
 using std::shared_ptr;
@@ -31,7 +35,11 @@ using std::string;
 using std::endl;
 
 MouseManager::MouseManager()
-    : dragHandler_({})
+    : dragMotionEvents(this, "drag_motion_events", 0)
+    , dragFrames(this, "drag_frames", 0)
+    , dragFrameTimeAverage(this, "drag_frame_usec_avg", 0)
+    , dragFrameTimeMax(this, "drag_frame_usec_max", 0)
+    , dragHandler_({})
     , clients_(nullptr)
     , monitors_(nullptr)
 {
@@ -45,6 +53,18 @@ MouseManager::MouseManager()
         { "resize",     &MouseManager::mouse_initiate_resize },
         { "call",       &MouseManager::mouse_call_command },
     };
+    dragMotionEvents.setDoc("the number of pointer motions during the "
+                            "current or last drag");
+    dragFrames.setDoc("the number of geometry updates during the current "
+                      "or last drag. This is less than 'drag_motion_events' "
+                      "if motions were combined because of the setting "
+                      "'drag_frame_rate'");
+    dragFrameTimeAverage.setDoc("the average time in microseconds it took to "
+                                "apply a geometry update during the current "
+                                "or last drag");
+    dragFrameTimeMax.setDoc("the maximum time in microseconds it took to "
+                            "apply a geometry update during the current "
+                            "or last drag");
 }
 
 MouseManager::~MouseManager() {
@@ -258,6 +278,13 @@ string MouseManager::mouse_initiate_drag(Client *client, const MouseDragHandler:
         dragHandler_->resizeAction_ = resize * client->possibleResizeActions();
         // only grab pointer if dragHandler_ could be started
         clients_->setDragged(client);
+        pendingCursor_ = {};
+        lastDragFrame_ = {};
+        dragFrameTimeTotal_ = {};
+        dragMotionEvents = 0;
+        dragFrames = 0;
+        dragFrameTimeAverage = 0;
+        dragFrameTimeMax = 0;
     }  catch (const MouseDragHandler::DragNotPossible& e) {
         // clear all fields, just to be sure
         dragHandler_ = {};
@@ -270,6 +297,8 @@ string MouseManager::mouse_initiate_drag(Client *client, const MouseDragHandler:
 
 void MouseManager::mouse_stop_drag() {
     // end those operations that have been started by mouse_initiate_drag()
+    // but first apply the last position of the cursor
+    applyPendingMotion(true);
     if (dragHandler_) {
         clients_->setDragged(nullptr);
         try {
@@ -285,10 +314,59 @@ void MouseManager::handle_motion_event(Point2D newCursorPos) {
     if (!dragHandler_) {
         return;
     }
+    dragMotionEvents = dragMotionEvents() + 1;
+    pendingCursor_ = newCursorPos;
+    applyPendingMotion(false);
+}
+
+/**
+ * @brief The time until the pending cursor motion is due to be applied,
+ * according to the setting 'drag_frame_rate'
+ * @return nothing, if there is no pending motion
+ */
+std::experimental::optional<microseconds> MouseManager::dragFrameTimeout()
+{
+    if (!pendingCursor_ || !dragHandler_) {
+        return {};
+    }
+    unsigned long rate = g_settings->drag_frame_rate();
+    if (rate == 0) {
+        return microseconds(0);
+    }
+    auto due = lastDragFrame_ + microseconds(1000000 / rate);
+    auto now = steady_clock::now();
+    if (due <= now) {
+        return microseconds(0);
+    }
+    return duration_cast<microseconds>(due - now);
+}
+
+/**
+ * @brief Pass the latest cursor position to the drag handler
+ * @param if set, do it even if the next frame is not due yet
+ */
+void MouseManager::applyPendingMotion(bool force)
+{
+    auto timeout = dragFrameTimeout();
+    if (!timeout || (!force && timeout->count() > 0)) {
+        return;
+    }
+    Point2D cursorPos = *pendingCursor_;
+    pendingCursor_ = {};
+    auto start = steady_clock::now();
+    lastDragFrame_ = start;
     try {
-        dragHandler_->handle_motion_event(newCursorPos);
+        dragHandler_->handle_motion_event(cursorPos);
     }  catch (const MouseDragHandler::DragNotPossible&) {
         mouse_stop_drag();
+        return;
+    }
+    auto duration = duration_cast<microseconds>(steady_clock::now() - start);
+    dragFrameTimeTotal_ += duration;
+    dragFrames = dragFrames() + 1;
+    dragFrameTimeAverage = static_cast<unsigned long>(dragFrameTimeTotal_.count()) / dragFrames();
+    if (static_cast<unsigned long>(duration.count()) > dragFrameTimeMax()) {
+        dragFrameTimeMax = duration.count();
     }
 }
 
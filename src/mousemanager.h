@@ -1,10 +1,12 @@
 #pragma once
 
 #include <X11/X.h>
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
 
+#include "attribute_.h"
 #include "mouse.h"
 #include "object.h"
 #include "optional.h"
@@ -35,6 +37,8 @@ public:
     void mouse_stop_drag();
     bool mouse_is_dragging();
     void handle_motion_event(Point2D newCursorPos);
+    std::experimental::optional<std::chrono::microseconds> dragFrameTimeout();
+    void applyPendingMotion(bool force);
 
     int dragCommand(Input input, Output output);
     void dragCompletion(Completion& complete);
@@ -46,6 +50,12 @@ public:
     std::string mouse_call_command(Client* client, const std::vector<std::string> &cmd);
     ResizeAction resizeAction();
 
+    // statistics about the current or the last drag:
+    Attribute_<unsigned long> dragMotionEvents;
+    Attribute_<unsigned long> dragFrames;
+    Attribute_<unsigned long> dragFrameTimeAverage;
+    Attribute_<unsigned long> dragFrameTimeMax;
+
 private:
     //! start dragging for the specified client (possibly up to some arguments), and return a error message
     //! if not possible
@@ -72,6 +82,10 @@ private:
 
     std::map<std::string, MouseFunction> mouseFunctions_;
     std::shared_ptr<MouseDragHandler> dragHandler_;
+    //! the latest cursor position that was not yet passed to the dragHandler_
+    std::experimental::optional<Point2D> pendingCursor_;
+    std::chrono::steady_clock::time_point lastDragFrame_;
+    std::chrono::microseconds dragFrameTimeTotal_ = {};
     Cursor cursor;
     ClientManager*  clients_;
     MonitorManager*  monitors_;
@@ -17,6 +17,7 @@ using std::make_shared;
 using std::pair;
 using std::shared_ptr;
 using std::string;
+using std::to_string;
 using std::vector;
 
 ChildEntry::ChildEntry(Object& owner, const string& name)
@@ -110,7 +111,30 @@ Attribute* Object::attribute(const string &name) {
 }
 
 
+//! parse the name of an indexed child, i.e. a decimal number
+//! without leading zeros
+static bool parseChildIndex(const string& name, size_t& index) {
+    if (name.empty() || name.size() > 9 || (name[0] == '0' && name.size() > 1)) {
+        return false;
+    }
+    index = 0;
+    for (char ch : name) {
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        index = index * 10 + static_cast<size_t>(ch - '0');
+    }
+    return true;
+}
+
 Object* Object::child(const string &name) {
+    size_t index;
+    if (parseChildIndex(name, index)) {
+        Object* indexed = indexedChild(index);
+        if (indexed) {
+            return indexed;
+        }
+    }
     auto it_dyn = childrenDynamic_.find(name);
     if (it_dyn != childrenDynamic_.end()) {
         return it_dyn->second();
@@ -229,6 +253,10 @@ std::map<string, Object*> Object::children() {
             allChildren[it.first] = obj;
         }
     }
+    size_t indexedCount = indexedChildCount();
+    for (size_t i = 0; i < indexedCount; i++) {
+        allChildren[to_string(i)] = indexedChild(i);
+    }
     return allChildren;
 }
 
@@ -98,6 +98,12 @@ protected:
     // initialize an attribute (typically used by init())
     virtual void wireAttributes(std::vector<Attribute*> attrs);
 
+    // objects having a list of children that are named by their index
+    // (e.g. IndexingObject) provide them via the following instead of
+    // maintaining an entry in children_ for each of them.
+    virtual size_t indexedChildCount() { return 0; }
+    virtual Object* indexedChild(size_t index) { return nullptr; }
+
     std::map<std::string, Attribute*> attribs_;
 
     std::map<std::string, std::function<Object*()>> childrenDynamic_;
@@ -94,6 +94,44 @@ public:
         }
         return {0, 0, 0, 0};
     };
+
+    //! everything computeReservedSpace() needs to know about a panel
+    class Footprint {
+    public:
+        //! the area of the panel that reserves space
+        Rectangle area_;
+        bool strutDefined_ = false;
+        bool verticalStrut_ = false;
+        bool horizontalStrut_ = false;
+        bool operator==(const Footprint& other) const {
+            return area_ == other.area_
+                && strutDefined_ == other.strutDefined_
+                && verticalStrut_ == other.verticalStrut_
+                && horizontalStrut_ == other.horizontalStrut_;
+        }
+        bool operator!=(const Footprint& other) const {
+            return !(*this == other);
+        }
+    };
+    //! the footprint, as of the last updateFootprint()
+    Footprint footprint_;
+
+    //! recompute the footprint and return the previous one
+    Footprint updateFootprint() {
+        Footprint previous = footprint_;
+        footprint_.area_ = wmStrutGeometry();
+        if (!footprint_.area_) {
+            // if the panel does not define WmStrut,
+            // then take it's window geometry
+            footprint_.area_ = size_;
+        }
+        footprint_.strutDefined_ = !wmStrut_.empty();
+        footprint_.verticalStrut_ =
+            wmStrut(WmStrut::left) > 0 || wmStrut(WmStrut::right) > 0;
+        footprint_.horizontalStrut_ =
+            wmStrut(WmStrut::top) > 0 || wmStrut(WmStrut::bottom) > 0;
+        return previous;
+    }
 };
 
 PanelManager::PanelManager(XConnection& xcon)
@@ -120,7 +158,6 @@ void PanelManager::registerPanel(Window win)
     panels_.insert(make_pair(win, p));
     addChild(p, Converter<WindowID>::str(win));
     updateReservedSpace(p, xcon_.windowSize(win));
-    panels_changed_.emit();
 }
 
 void PanelManager::unregisterPanel(Window win)
@@ -130,10 +167,11 @@ void PanelManager::unregisterPanel(Window win)
         return;
     }
     Panel* p = it->second;
+    Rectangle area = p->footprint_.area_;
     panels_.erase(win);
     removeChild(Converter<WindowID>::str(win));
     delete p;
-    panels_changed_.emit();
+    panel_area_changed_.emit({ area });
 }
 
 void PanelManager::propertyChanged(Window win, Atom property)
@@ -143,10 +181,7 @@ void PanelManager::propertyChanged(Window win, Atom property)
     }
     auto it = panels_.find(win);
     if (it != panels_.end()) {
-        Panel* p = it->second;
-        if (updateReservedSpace(p, xcon_.windowSize(win))) {
-            panels_changed_.emit();
-        }
+        updateReservedSpace(it->second, xcon_.windowSize(win));
     }
 }
 
@@ -160,10 +195,7 @@ void PanelManager::geometryChanged(Window win, Rectangle geometry)
 {
     auto it = panels_.find(win);
     if (it != panels_.end()) {
-        Panel* p = it->second;
-        if (updateReservedSpace(p, geometry)) {
-            panels_changed_.emit();
-        }
+        updateReservedSpace(it->second, geometry);
     }
 }
 
@@ -176,22 +208,24 @@ void PanelManager::injectDependencies(Settings* settings)
 }
 
 /**
- * read the reserved space from the panel window and return if there are changes
+ * read the reserved space from the panel window and announce the
+ * affected area if the panel's footprint changed
  * - size is the geometry of the panel
  */
-bool PanelManager::updateReservedSpace(Panel* p, Rectangle size)
+void PanelManager::updateReservedSpace(Panel* p, Rectangle size)
 {
     auto optionalWmStrut = xcon_.getWindowPropertyCardinal(p->winid_(), atomWmStrutPartial_);
     if (!optionalWmStrut) {
         optionalWmStrut= xcon_.getWindowPropertyCardinal(p->winid_(), atomWmStrut_);
     }
-    vector<long> wmStrut = optionalWmStrut.value_or(vector<long>());
-    if (p->wmStrut_ != wmStrut || p->size_ != size) {
-        p->wmStrut_ = wmStrut;
-        p->size_ = size;
-        return true;
+    p->wmStrut_ = optionalWmStrut.value_or(vector<long>());
+    p->size_ = size;
+    Panel::Footprint previous = p->updateFootprint();
+    if (previous != p->footprint_) {
+        // only the monitors intersecting the old or the new
+        // area of the panel are affected
+        panel_area_changed_.emit({ previous.area_, p->footprint_.area_ });
     }
-    return false;
 }
 
 
@@ -203,15 +237,9 @@ PanelManager::ReservedSpace PanelManager::computeReservedSpace(Rectangle mon)
         return rsTotal;
     }
     for (auto it : panels_) {
-        Panel& p = *(it.second);
+        const Panel::Footprint& p = it.second->footprint_;
         ReservedSpace rs;
-        Rectangle panelArea = p.wmStrutGeometry();
-        if (!panelArea) {
-            // if the panel does not define WmStrut,
-            // then take it's window geometry
-            panelArea = p.size_;
-        }
-        Rectangle intersection = mon.intersectionWith(panelArea);
+        Rectangle intersection = mon.intersectionWith(p.area_);
         if (!intersection) {
             // monitor does not intersect with panel at all
             continue;
@@ -219,9 +247,9 @@ PanelManager::ReservedSpace PanelManager::computeReservedSpace(Rectangle mon)
         // we only reserve space for the panel if the panel defines
         // wmStrut_ or if the aspect ratio clearly indicates whether the
         // panel is horizontal or vertical
-        bool verticalPanel = p.wmStrut(WmStrut::left) > 0 || p.wmStrut(WmStrut::right) > 0;
-        bool horizontalPanel = p.wmStrut(WmStrut::top) > 0 || p.wmStrut(WmStrut::bottom) > 0;
-        if (p.wmStrut_.empty()) {
+        bool verticalPanel = p.verticalStrut_;
+        bool horizontalPanel = p.horizontalStrut_;
+        if (!p.strutDefined_) {
             // only fall back to aspect ratio if wmStrut is undefined
             verticalPanel = intersection.height > intersection.width;
             horizontalPanel = intersection.height < intersection.width;
@@ -257,6 +285,17 @@ void PanelManager::rootWindowChanged(int width, int height)
 {
     rootWindowGeometry_.width = width;
     rootWindowGeometry_.height = height;
+    // the strut geometry is relative to the root window's edges
+    bool changed = false;
+    for (auto it : panels_) {
+        Panel* p = it.second;
+        if (p->updateFootprint() != p->footprint_) {
+            changed = true;
+        }
+    }
+    if (changed) {
+        panels_changed_.emit();
+    }
 }
 
 int& PanelManager::ReservedSpace::operator[](size_t idx)
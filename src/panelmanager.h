@@ -42,7 +42,10 @@ public:
     void geometryChanged(Window win, Rectangle size);
     void injectDependencies(Settings* settings);
     ReservedSpace computeReservedSpace(Rectangle monitorDimension);
+    //! the reserved space may have changed anywhere
     Signal panels_changed_;
+    //! the reserved space may have changed within the given areas
+    Signal_<RectangleVec> panel_area_changed_;
     void rootWindowChanged(int width, int height);
     DynAttribute_<unsigned long> count;
 private:
@@ -50,7 +53,7 @@ private:
     unsigned long getCount() {
         return static_cast<unsigned long>(panels_.size());
     };
-    bool updateReservedSpace(Panel* p, Rectangle geometry);
+    void updateReservedSpace(Panel* p, Rectangle geometry);
 
     std::unordered_map<Window, Panel*> panels_;
     Atom atomWmStrut_;
@@ -1,54 +1,79 @@
 #pragma once
 
-#include <algorithm>
 #include <cassert>
-#include <vector>
+#include <iterator>
+#include <list>
+#include <unordered_map>
 
+/*! A stack of distinct elements. Every element knows its position in the
+ * underlying list, so inserting, removing, raising and lowering an element
+ * takes constant time.
+ */
 template<typename T>
 class PlainStack {
 public:
+    PlainStack() = default;
+    // the positions point into data_, so a copy would be invalid
+    PlainStack(const PlainStack&) = delete;
+    PlainStack& operator=(const PlainStack&) = delete;
+
     //! insert at the top
     void insert(const T& element, bool insertOnTop = true) {
-        if (insertOnTop) {
-            data_.insert(data_.begin(), element);
-        } else {
-            data_.push_back(element);
+        remove(element);
+        auto it = data_.insert(insertOnTop ? data_.begin() : data_.end(),
+                               element);
+        position_[element] = it;
+    }
+    //! remove the element and return whether it was contained
+    bool remove(const T& element) {
+        auto pos = position_.find(element);
+        if (pos == position_.end()) {
+            return false;
+        }
+        data_.erase(pos->second);
+        position_.erase(pos);
+        return true;
+    }
+    //! move to the top and return whether the order changed
+    bool raise(const T& element) {
+        auto pos = position_.find(element);
+        assert(pos != position_.end());
+        if (pos->second == data_.begin()) {
+            return false;
         }
+        // move the element to the front without invalidating iterators
+        data_.splice(data_.begin(), data_, pos->second);
+        return true;
     }
-    void remove(const T& element) {
-        data_.erase(std::remove(data_.begin(), data_.end(), element), data_.end());
-    }
-    void raise(const T& element) {
-        auto it = std::find(data_.begin(), data_.end(), element);
-        assert(it != data_.end());
-        // rotate the range [begin, it+1) in such a way
-        // that it becomes the new first element
-        std::rotate(data_.begin(), it, it + 1);
-    }
-    void lower(const T& element) {
-        auto it = std::find(data_.begin(), data_.end(), element);
-        assert(it != data_.end());
-        // rotate the range (it, end] in such a way
-        // that it+1 becomes the first element. Hence,
-        // it must have become the last element.
-        std::rotate(it, it + 1, data_.end());
-    }
-    typename std::vector<T>::const_iterator begin() const {
+    //! move to the bottom and return whether the order changed
+    bool lower(const T& element) {
+        auto pos = position_.find(element);
+        assert(pos != position_.end());
+        if (std::next(pos->second) == data_.end()) {
+            return false;
+        }
+        data_.splice(data_.end(), data_, pos->second);
+        return true;
+    }
+    typename std::list<T>::const_iterator begin() const {
         return data_.cbegin();
     }
-    typename std::vector<T>::const_iterator end() const {
+    typename std::list<T>::const_iterator end() const {
         return data_.cend();
     }
-    typename std::vector<T>::const_reverse_iterator rbegin() const {
+    typename std::list<T>::const_reverse_iterator rbegin() const {
         return data_.rbegin();
     }
-    typename std::vector<T>::const_reverse_iterator rend() const {
+    typename std::list<T>::const_reverse_iterator rend() const {
         return data_.rend();
     }
     bool empty() const {
         return data_.empty();
     }
+    size_t size() const {
+        return data_.size();
+    }
 private:
-    std::vector<T> data_;
+    std::list<T> data_;
+    std::unordered_map<T, typename std::list<T>::iterator> position_;
 };
-
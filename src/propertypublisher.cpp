@@ -0,0 +1,162 @@
+#include "propertypublisher.h"
+
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+
+#include "xconnection.h"
+
+using std::string;
+using std::vector;
+
+PropertyPublisher::PropertyPublisher(XConnection& X)
+    : writes_(this, "writes", 0)
+    , writesSuppressed_(this, "writes_suppressed", 0)
+    , X_(X)
+{
+    setDoc("The X11 properties published on the root window and "
+           "on client windows according to the EWMH specification.");
+    writes_.setDoc("the number of properties written");
+    writesSuppressed_.setDoc("the number of property updates that were "
+                             "not written, because they did not change the "
+                             "property value or because they were overwritten "
+                             "before the next flush");
+}
+
+void PropertyPublisher::setString(Window window, Atom property, const string& value)
+{
+    Value v;
+    v.type_ = Value::Type::String;
+    v.strings_ = { value };
+    set(window, property, v);
+}
+
+void PropertyPublisher::setStringList(Window window, Atom property, const vector<string>& value)
+{
+    Value v;
+    v.type_ = Value::Type::StringList;
+    v.strings_ = value;
+    set(window, property, v);
+}
+
+void PropertyPublisher::setWindow(Window window, Atom property, const vector<Window>& value)
+{
+    Value v;
+    v.type_ = Value::Type::WindowList;
+    v.numbers_ = vector<long>(value.begin(), value.end());
+    set(window, property, v);
+}
+
+void PropertyPublisher::setCardinal(Window window, Atom property, const vector<long>& value)
+{
+    Value v;
+    v.type_ = Value::Type::CardinalList;
+    v.numbers_ = value;
+    set(window, property, v);
+}
+
+void PropertyPublisher::setAtom(Window window, Atom property, const vector<Atom>& value)
+{
+    Value v;
+    v.type_ = Value::Type::AtomList;
+    v.numbers_ = vector<long>(value.begin(), value.end());
+    set(window, property, v);
+}
+
+void PropertyPublisher::deleteProperty(Window window, Atom property)
+{
+    set(window, property, {});
+}
+
+void PropertyPublisher::forgetWindow(Window window)
+{
+    auto begin = entries_.lower_bound(Key(window, 0));
+    auto end = begin;
+    while (end != entries_.end() && end->first.first == window) {
+        end++;
+    }
+    entries_.erase(begin, end);
+}
+
+void PropertyPublisher::set(Window window, Atom property, Value value)
+{
+    Key key = { window, property };
+    Entry& entry = entries_[key];
+    if (entry.dirty_) {
+        // the pending value is replaced before it was ever written
+        writesSuppressed_ = writesSuppressed_() + 1;
+    } else if (entry.published_ && entry.publishedValue_ == value) {
+        writesSuppressed_ = writesSuppressed_() + 1;
+        return;
+    } else {
+        entry.dirty_ = true;
+        dirtyKeys_.push_back(key);
+    }
+    entry.pendingValue_ = std::move(value);
+}
+
+void PropertyPublisher::flush()
+{
+    if (dirtyKeys_.empty()) {
+        return;
+    }
+    unsigned long writeCount = 0;
+    unsigned long suppressedCount = 0;
+    for (const Key& key : dirtyKeys_) {
+        auto it = entries_.find(key);
+        if (it == entries_.end() || !it->second.dirty_) {
+            // the window was forgotten in the meantime
+            continue;
+        }
+        Entry& entry = it->second;
+        entry.dirty_ = false;
+        if (entry.published_ && entry.publishedValue_ == entry.pendingValue_) {
+            // the value was changed back before the flush
+            suppressedCount++;
+            continue;
+        }
+        write(key, entry.pendingValue_);
+        writeCount++;
+        entry.publishedValue_ = std::move(entry.pendingValue_);
+        entry.pendingValue_ = {};
+        entry.published_ = true;
+    }
+    dirtyKeys_.clear();
+    if (writeCount > 0) {
+        writes_ = writes_() + writeCount;
+    }
+    if (suppressedCount > 0) {
+        writesSuppressed_ = writesSuppressed_() + suppressedCount;
+    }
+}
+
+void PropertyPublisher::write(Key key, const Value& value)
+{
+    Window window = key.first;
+    Atom property = key.second;
+    switch (value.type_) {
+        case Value::Type::Deleted:
+            X_.deleteProperty(window, property);
+            break;
+        case Value::Type::String:
+            X_.setPropertyString(window, property, value.strings_.front());
+            break;
+        case Value::Type::StringList:
+            X_.setPropertyString(window, property, value.strings_);
+            break;
+        case Value::Type::WindowList:
+            X_.setPropertyWindow(window, property,
+                vector<Window>(value.numbers_.begin(), value.numbers_.end()));
+            break;
+        case Value::Type::CardinalList:
+            X_.setPropertyCardinal(window, property, value.numbers_);
+            break;
+        case Value::Type::AtomList:
+            // according to the XChangeProperty-specification:
+            // if format = 32, then the data must be a long array.
+            XChangeProperty(X_.display(), window, property, XA_ATOM, 32,
+                            PropModeReplace,
+                            (unsigned char*)(value.numbers_.data()),
+                            value.numbers_.size());
+            break;
+    }
+}
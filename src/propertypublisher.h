@@ -0,0 +1,74 @@
+#pragma once
+
+#include <X11/X.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "attribute_.h"
+#include "object.h"
+
+class XConnection;
+
+/**
+ * @brief Collects the X11 properties the window manager publishes on the
+ * root window and on client windows. Writes are postponed until flush()
+ * and a property is only written if its value differs from the value
+ * published last, because pagers, panels and compositors react on
+ * every property change.
+ */
+class PropertyPublisher : public Object {
+public:
+    PropertyPublisher(XConnection& X);
+    void setString(Window window, Atom property, const std::string& value);
+    void setStringList(Window window, Atom property, const std::vector<std::string>& value);
+    void setWindow(Window window, Atom property, const std::vector<Window>& value);
+    void setCardinal(Window window, Atom property, const std::vector<long>& value);
+    void setAtom(Window window, Atom property, const std::vector<Atom>& value);
+    void deleteProperty(Window window, Atom property);
+    //! drop all pending and published values of a window
+    void forgetWindow(Window window);
+    //! write all properties that have changed since the last flush
+    void flush();
+
+    Attribute_<unsigned long> writes_;
+    Attribute_<unsigned long> writesSuppressed_;
+private:
+    class Value {
+    public:
+        enum class Type {
+            Deleted,
+            String,
+            StringList,
+            WindowList,
+            CardinalList,
+            AtomList,
+        };
+        Type type_ = Type::Deleted;
+        std::vector<std::string> strings_;
+        std::vector<long> numbers_;
+        bool operator==(const Value& other) const {
+            return type_ == other.type_
+                && strings_ == other.strings_
+                && numbers_ == other.numbers_;
+        }
+        bool operator!=(const Value& other) const {
+            return !(*this == other);
+        }
+    };
+    class Entry {
+    public:
+        bool published_ = false; //! whether publishedValue_ is valid
+        bool dirty_ = false; //! whether pendingValue_ needs to be written
+        Value publishedValue_;
+        Value pendingValue_;
+    };
+    typedef std::pair<Window, Atom> Key;
+    void set(Window window, Atom property, Value value);
+    void write(Key key, const Value& value);
+    XConnection& X_;
+    std::map<Key, Entry> entries_;
+    //! the entries with dirty_ = true, in the order of their first change
+    std::vector<Key> dirtyKeys_;
+};
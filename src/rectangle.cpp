@@ -1,13 +1,16 @@
 #include "rectangle.h"
 
 #include <X11/Xutil.h>
+#include <algorithm>
 #include <limits>
-#include <queue>
+#include <map>
 
 #include "ipc-protocol.h"
 #include "utils.h"
 
 using std::endl;
+using std::make_pair;
+using std::pair;
 using std::string;
 using std::vector;
 
@@ -135,74 +138,105 @@ std::ostream& operator<< (std::ostream& stream, const Rectangle& rect) {
     return stream;
 }
 
-static RectangleVec disjoin_from_subset(Rectangle large, Rectangle center)
-{
-    // given a large rectangle and a center which guaranteed to be a subset of
-    // the large rect, the task is to split "large" into pieces and insert them
-    // like this:
-    //
-    // +------- large ---------+
-    // |         top           |
-    // |------+--------+-------|
-    // | left | center | right |
-    // |------+--------+-------|
-    // |        bottom         |
-    // +-----------------------+
-    // coordinates of the bottom right corner of large
-    int br_x = large.x + large.width, br_y = large.y + large.height;
-    auto r = Rectangle::fromCorners;
-    Rectangle top   = r(large.x, large.y, large.x + large.width, center.y);
-    Rectangle left  = r(large.x, center.y, center.x, center.y + center.height);
-    Rectangle right = r(center.x + center.width, center.y, br_x, center.y + center.height);
-    Rectangle bottom= r(large.x, center.y + center.height, br_x, br_y);
-
-    RectangleVec parts = { top, left, right, bottom };
-    RectangleVec res;
-    for (auto& rect : parts ) {
-        if (rect.width <= 0 || rect.height <= 0) {
+/**
+ * @brief Split the given rectangles into disjoint pieces covering the same
+ * area. Every piece is either contained in or disjoint from each of the
+ * given rectangles, so overlapping areas become pieces of their own.
+ *
+ * The borders of the rectangles split the plane into a grid of cells, and
+ * each cell is covered by a fixed set of rectangles. Adjacent cells with
+ * the same set are merged, first within a row and then across rows, so the
+ * result never has more pieces than there are grid cells, no matter how
+ * the rectangles overlap.
+ *
+ * The pieces are grouped by the first given rectangle containing them, in
+ * the order of the given rectangles, so e.g. the pieces of the primary
+ * monitor come first. Within a group, pieces shared with more rectangles
+ * come first, the others are sorted row by row.
+ */
+RectangleVec disjoin_rects(const RectangleVec &buf) {
+    vector<int> xs, ys;
+    for (const auto& r : buf) {
+        if (r.width <= 0 || r.height <= 0) {
             continue;
         }
-        res.push_back(rect);
+        xs.push_back(r.x);
+        xs.push_back(r.x + r.width);
+        ys.push_back(r.y);
+        ys.push_back(r.y + r.height);
     }
-    return res;
-}
-
-RectangleVec disjoin_rects(const RectangleVec &buf) {
-    std::queue<Rectangle> q; // rectangles not inserted yet
-    for (const auto& r : buf) {
-        q.push(r);
+    for (auto* coords : { &xs, &ys }) {
+        std::sort(coords->begin(), coords->end());
+        coords->erase(std::unique(coords->begin(), coords->end()), coords->end());
     }
-    RectangleVec result; // rectangles that are disjoint
-    while (!q.empty()) {
-        auto rectToInsert = q.front();
-        q.pop();
-        // find some rectangle in 'result' that intersects with rectToInsert
-        size_t i;
-        for (i = 0; i < result.size(); i++) {
-            if (result[i].intersectionWith(rectToInsert)) {
-                break;
+    auto column = [&xs](int x) -> size_t {
+        return std::lower_bound(xs.begin(), xs.end(), x) - xs.begin();
+    };
+    // a piece of the result in grid coordinates, together with
+    // the set of rectangles containing it
+    struct Piece {
+        size_t x1, x2, y1, y2;
+        vector<bool> coveredBy;
+    };
+    vector<Piece> pieces;
+    // the pieces reaching down to the current row, by their columns
+    std::map<pair<size_t, size_t>, size_t> open;
+    size_t columnCount = xs.empty() ? 0 : xs.size() - 1;
+    for (size_t row = 0; row + 1 < ys.size(); row++) {
+        vector<vector<bool>> cells(columnCount, vector<bool>(buf.size(), false));
+        vector<bool> covered(columnCount, false);
+        for (size_t i = 0; i < buf.size(); i++) {
+            const Rectangle& r = buf[i];
+            if (r.width <= 0 || r.height <= 0
+                || r.y > ys[row] || r.y + r.height <= ys[row]) {
+                continue;
+            }
+            for (size_t col = column(r.x); col < column(r.x + r.width); col++) {
+                cells[col][i] = true;
+                covered[col] = true;
             }
         }
-        if (i >= result.size()) {
-            // no intersection means, we can insert it without any issue
-            result.push_back(rectToInsert);
-        } else {
-            // if there's an intersection
-            Rectangle center = result[i].intersectionWith(rectToInsert);
-            // then cut both rectangles into pieces according to the intersection:
-            // 1. all rectangles of 'result' are invariantly disjoint, and so we can add them
-            // to the result
-            for (const auto& r : disjoin_from_subset(result[i], center)) {
-                result.push_back(r);
+        std::map<pair<size_t, size_t>, size_t> nextOpen;
+        size_t col = 0;
+        while (col < columnCount) {
+            if (!covered[col]) {
+                col++;
+                continue;
             }
-            // and we can replace result[i] by the intersection
-            result[i] = center;
-            // 2. the other pieces of rectToInsert possibly intersect with other rectangles,
-            // so process them later
-            for (const auto& r : disjoin_from_subset(rectToInsert, center)) {
-                q.push(r);
+            size_t end = col + 1;
+            while (end < columnCount && cells[end] == cells[col]) {
+                end++;
             }
+            auto key = make_pair(col, end);
+            auto it = open.find(key);
+            if (it != open.end() && pieces[it->second].coveredBy == cells[col]) {
+                // extend the piece from the previous row
+                pieces[it->second].y2 = row + 1;
+                nextOpen[key] = it->second;
+            } else {
+                pieces.push_back({col, end, row, row + 1, cells[col]});
+                nextOpen[key] = pieces.size() - 1;
+            }
+            col = end;
         }
+        open = std::move(nextOpen);
+    }
+    auto groupKey = [](const Piece& p) {
+        size_t first = std::find(p.coveredBy.begin(), p.coveredBy.end(), true)
+                       - p.coveredBy.begin();
+        long count = std::count(p.coveredBy.begin(), p.coveredBy.end(), true);
+        return make_pair(first, -count);
+    };
+    // the pieces are created row by row, so a stable sort keeps this
+    // order within each group
+    std::stable_sort(pieces.begin(), pieces.end(),
+                     [&groupKey](const Piece& a, const Piece& b) {
+        return groupKey(a) < groupKey(b);
+    });
+    RectangleVec result;
+    for (const auto& p : pieces) {
+        result.push_back(Rectangle::fromCorners(xs[p.x1], ys[p.y1],
+                                                xs[p.x2], ys[p.y2]));
     }
     return result;
 }
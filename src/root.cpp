@@ -14,6 +14,7 @@
 #include "monitormanager.h"
 #include "mousemanager.h"
 #include "panelmanager.h"
+#include "propertypublisher.h"
 #include "rulemanager.h"
 #include "settings.h"
 #include "tag.h"
@@ -31,6 +32,7 @@ shared_ptr<Root> Root::root_;
 Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer)
     : autostart(*this, "autostart")
     , clients(*this, "clients")
+    , ewmhPublisher(*this, "ewmh")
     , keys(*this, "keys")
     , monitors(*this, "monitors")
     , mouse(*this, "mouse")
@@ -66,6 +68,7 @@ Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer
 
     // inject dependencies where needed
     ewmh_.injectDependencies(this);
+    ewmhPublisher = &ewmh_.publisher();
     settings->injectDependencies(this);
     tags->injectDependencies(monitors(), settings());
     clients->injectDependencies(settings(), theme(), &ewmh_);
@@ -85,7 +88,10 @@ Root::Root(Globals g, XConnection& xconnection, Ewmh& ewmh, IpcServer& ipcServer
         c->tag()->applyClientState(c);
     });
     theme->theme_changed_.connect(monitors(), &MonitorManager::relayoutAll);
-    panels->panels_changed_.connect(monitors(), &MonitorManager::autoUpdatePads);
+    panels->panels_changed_.connect([this]() { monitors()->autoUpdatePads(); });
+    panels->panel_area_changed_.connect([this](RectangleVec areas) {
+        monitors()->autoUpdatePadsIn(areas);
+    });
 }
 
 Root::~Root() {
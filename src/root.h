@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "child.h"
+#include "link.h"
 #include "object.h"
 
 // new object tree root.
@@ -19,6 +20,7 @@ class KeyManager; // IWYU pragma: keep
 class MonitorManager; // IWYU pragma: keep
 class MouseManager; // IWYU pragma: keep
 class PanelManager;
+class PropertyPublisher;
 class MetaCommands;
 class RuleManager; // IWYU pragma: keep
 class Settings; // IWYU pragma: keep
@@ -57,6 +59,7 @@ public:
     // (in alphabetical order)
     Child_<Autostart> autostart;
     Child_<ClientManager> clients;
+    Link_<PropertyPublisher> ewmhPublisher;
     Child_<KeyManager> keys;
     Child_<MonitorManager> monitors;
     Child_<MouseManager> mouse;
@@ -287,11 +287,11 @@ bool Condition::matches(const string& str) const {
 }
 
 bool Condition::matchesClass(const Client* client) const {
-    return matches(Root::get()->X.getClass(client->window_));
+    return matches(client->windowClass());
 }
 
 bool Condition::matchesInstance(const Client* client) const {
-    return matches(Root::get()->X.getInstance(client->window_));
+    return matches(client->windowInstance());
 }
 
 bool Condition::matchesTitle(const Client* client) const {
@@ -331,7 +331,7 @@ bool Condition::matchesMaxage(const Client* client) const {
 
 bool Condition::matchesWindowtype(const Client* client) const {
     auto& ewmh = Ewmh::get();
-    int wintype = ewmh.getWindowType(client->x11Window());
+    int wintype = client->windowType();
     if (wintype < 0) {
         return false;
     }
@@ -339,9 +339,7 @@ bool Condition::matchesWindowtype(const Client* client) const {
 }
 
 bool Condition::matchesWindowrole(const Client* client) const {
-    auto& X = Root::get()->X;
-    auto role = X.getWindowProperty(client->window_, X.atom("WM_WINDOW_ROLE"));
-
+    auto role = client->windowRole();
     if (!role.has_value()) {
         return false;
     }
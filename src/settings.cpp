@@ -76,9 +76,14 @@ Settings::Settings()
         &smart_window_surroundings,
         &monitors_locked,
         &auto_detect_monitors,
+        &auto_detect_monitors_delay,
         &auto_detect_panels,
+        &keychain_timeout,
         &pseudotile_center_threshold,
         &update_dragged_clients,
+        &drag_frame_rate,
+        &drag_outline,
+        &tag_status_hook,
         &tree_style,
         &wmname,
 
@@ -62,9 +62,14 @@ public:
     Attribute_<bool>          smart_window_surroundings = {"smart_window_surroundings", false};
     Attribute_<unsigned long> monitors_locked = {"monitors_locked", 0};
     Attribute_<bool>          auto_detect_monitors = {"auto_detect_monitors", false};
+    Attribute_<unsigned long> auto_detect_monitors_delay = {"auto_detect_monitors_delay", 200};
     Attribute_<bool>          auto_detect_panels = {"auto_detect_panels", true};
+    Attribute_<unsigned long> keychain_timeout = {"keychain_timeout", 2000};
     Attribute_<int>           pseudotile_center_threshold = {"pseudotile_center_threshold", 10};
     Attribute_<bool>          update_dragged_clients = {"update_dragged_clients", false};
+    Attribute_<unsigned long> drag_frame_rate = {"drag_frame_rate", 0};
+    Attribute_<bool>          drag_outline = {"drag_outline", false};
+    Attribute_<bool>          tag_status_hook = {"tag_status_hook", false};
     Attribute_<string>        tree_style = {"tree_style", "*| +`--."};
     Attribute_<string>        wmname = {"wmname", WINDOW_MANAGER_NAME};
     // for compatibility
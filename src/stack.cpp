@@ -1,7 +1,9 @@
 #include "stack.h"
 
 #include <X11/Xlib.h>
+#include <algorithm>
 #include <string>
+#include <unordered_map>
 
 #include "client.h"
 #include "ewmh.h"
@@ -9,6 +11,7 @@
 #include "utils.h"
 
 using std::function;
+using std::pair;
 using std::string;
 using std::stringstream;
 using std::vector;
@@ -81,6 +84,7 @@ void Stack::removeSlice(Slice* elem) {
     for (auto layer : elem->layers) {
         layers_[layer].remove(elem);
     }
+    removalCount_++;
     dirty = true;
 }
 
@@ -141,16 +145,18 @@ void Stack::extractWindows(bool real_clients, function<void(Window)> yield) {
 
 void Stack::raiseSlice(Slice* slice) {
     for (auto layer : slice->layers) {
-        layers_[layer].raise(slice);
+        if (layers_[layer].raise(slice)) {
+            dirty = true;
+        }
     }
-    dirty = true;
 }
 
 void Stack::lowerSlice(Slice* slice) {
     for (auto layer : slice->layers) {
-        layers_[layer].lower(slice);
+        if (layers_[layer].lower(slice)) {
+            dirty = true;
+        }
     }
-    dirty = true;
 }
 
 
@@ -169,8 +175,9 @@ void Stack::sliceAddLayer(Slice* slice, HSLayer layer, bool insertOnTop) {
 
 void Stack::sliceRemoveLayer(Slice* slice, HSLayer layer) {
     /* remove slice from layer in the stack */
-    layers_[layer].remove(slice);
-    dirty = true;
+    if (layers_[layer].remove(slice)) {
+        dirty = true;
+    }
 
     if (slice->layers.count(layer) == 0) {
         return;
@@ -186,7 +193,71 @@ bool Stack::isLayerEmpty(HSLayer layer) {
 void Stack::clearLayer(HSLayer layer) {
     while (!isLayerEmpty(layer)) {
         sliceRemoveLayer(*layers_[layer].begin(), layer);
-        dirty = true;
     }
 }
 
+
+/**
+ * @brief Compute how to turn one stacking order into another one with
+ * few restack operations. Both lists are ordered from top to bottom and
+ * the first window of newOrder is expected to keep its position. The
+ * windows of the longest subsequence that is common to both lists (in the
+ * sense that their relative order in newOrder is the same as in oldOrder)
+ * keep their positions, every other window needs to be moved.
+ * @param the stacking order that was established previously
+ * @param the desired stacking order
+ * @return a list of pairs (w, sibling) meaning that w has to be moved
+ * directly below sibling. The operations have to be applied in the
+ * returned order.
+ */
+vector<pair<Window, Window>> Stack::restackOperations(
+                                    const vector<Window>& oldOrder,
+                                    const vector<Window>& newOrder)
+{
+    if (newOrder.size() < 2) {
+        return {};
+    }
+    std::unordered_map<Window, size_t> oldIndex;
+    for (size_t i = 0; i < oldOrder.size(); i++) {
+        oldIndex[oldOrder[i]] = i;
+    }
+    // longest increasing subsequence of old indices in newOrder, computed
+    // by patience sorting: tailIdx[l] is the position in newOrder of the
+    // smallest possible tail of an increasing subsequence of length l + 1
+    vector<size_t> tailIdx;
+    vector<size_t> tailOld;
+    const size_t none = newOrder.size();
+    vector<size_t> predecessor(newOrder.size(), none);
+    // the first window is fixed
+    vector<bool> keep(newOrder.size(), false);
+    keep[0] = true;
+    for (size_t i = 1; i < newOrder.size(); i++) {
+        auto it = oldIndex.find(newOrder[i]);
+        if (it == oldIndex.end()) {
+            continue;
+        }
+        size_t old = it->second;
+        size_t len = std::lower_bound(tailOld.begin(), tailOld.end(), old)
+                     - tailOld.begin();
+        predecessor[i] = (len > 0) ? tailIdx[len - 1] : none;
+        if (len == tailOld.size()) {
+            tailOld.push_back(old);
+            tailIdx.push_back(i);
+        } else {
+            tailOld[len] = old;
+            tailIdx[len] = i;
+        }
+    }
+    if (!tailIdx.empty()) {
+        for (size_t i = tailIdx.back(); i != none; i = predecessor[i]) {
+            keep[i] = true;
+        }
+    }
+    vector<pair<Window, Window>> operations;
+    for (size_t i = 1; i < newOrder.size(); i++) {
+        if (!keep[i]) {
+            operations.push_back({newOrder[i], newOrder[i - 1]});
+        }
+    }
+    return operations;
+}
@@ -6,6 +6,8 @@
 #include <functional>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "plainstack.h"
 
@@ -67,12 +69,23 @@ public:
     void clearLayer(HSLayer layer);
 
     void extractWindows(bool real_clients, std::function<void(Window)> yield);
+    //! whether the stacking order has changed since the last markClean()
+    bool isDirty() const { return dirty; }
+    void markDirty() { dirty = true; }
+    void markClean() { dirty = false; }
+    //! the number of slices that have been removed from this stack so far
+    unsigned long removalCount() const { return removalCount_; }
+
+    static std::vector<std::pair<Window, Window>> restackOperations(
+                                    const std::vector<Window>& oldOrder,
+                                    const std::vector<Window>& newOrder);
 
     PlainStack<Slice*> layers_[LAYER_COUNT];
 
 private:
     //! Whether the stacking order has changed but wasn't restacked yet
     bool dirty = false;
+    unsigned long removalCount_ = 0;
 };
 
 #endif
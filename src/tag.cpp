@@ -5,8 +5,10 @@
 
 #include "argparse.h"
 #include "client.h"
+#include "clientedgeindex.h"
 #include "clientmanager.h"
 #include "completion.h"
+#include "decoration.h"
 #include "ewmh.h"
 #include "floating.h"
 #include "frametree.h"
@@ -28,7 +30,6 @@ using std::shared_ptr;
 using std::string;
 using std::stringstream;
 
-static bool    g_tag_flags_dirty = true;
 
 HSTag::HSTag(string name_, TagManager* tags, Settings* settings)
     : frame(*this, "tiling")
@@ -46,13 +47,13 @@ HSTag::HSTag(string name_, TagManager* tags, Settings* settings)
     , curframe_wcount(this, "curframe_wcount",
         [this] () { return frame->focusedFrame()->clientCount(); } )
     , focused_client(*this, "focused_client", &HSTag::focusedClient)
-    , flags(0)
     , floating_clients_focus_(0)
     , oldName_(name_)
     , tags_(tags)
     , settings_(settings)
 {
     stack = make_shared<Stack>();
+    edgeIndex = make_shared<ClientEdgeIndex>();
     frame.init(this, settings);
     index.changed().connect([this, tags](unsigned long newIdx) {
         tags->indexChangeRequested(this, newIdx);
@@ -177,6 +178,13 @@ void HSTag::setVisible(bool newVisible)
             c->set_visible(visible);
         }
     }
+    if (visible) {
+        // catch up on decoration redraws (e.g. title changes)
+        // that were skipped while the tag was invisible
+        foreachClient([](Client* client) {
+            client->dec->redrawIfDeferred();
+        });
+    }
 }
 
 bool HSTag::removeClient(Client* client) {
@@ -237,27 +245,16 @@ void HSTag::focusFrame(shared_ptr<FrameLeaf> frameToFocus)
  */
 Client* HSTag::minimizedClient(bool oldest)
 {
-    Client* chosen = nullptr;
-    for (Client* c : floating_clients_) {
-        if (!c->minimized_()) {
-            continue;
-        }
-        // always pick c if chosen is still null
-        bool cIsBetter = chosen == nullptr;
-        if (oldest) {
-            // looking for the longest minimized client
-            // by the lazy `||` we are safe if chosen == nullptr
-            cIsBetter = cIsBetter || c->minimizedLastChange_ < chosen->minimizedLastChange_;
-        } else {
-            // looking for the most recently minimized client
-            // by the lazy `||` we are safe if chosen == nullptr
-            cIsBetter = cIsBetter || c->minimizedLastChange_ > chosen->minimizedLastChange_;
-        }
-        if (cIsBetter) {
-            chosen = c;
-        }
+    if (minimizedClients_.empty()) {
+        return nullptr;
+    }
+    if (oldest) {
+        // the longest minimized client
+        return minimizedClients_.begin()->second;
+    } else {
+        // the most recently minimized client
+        return minimizedClients_.rbegin()->second;
     }
-    return chosen;
 }
 
 Client *HSTag::focusedClient()
@@ -623,43 +620,50 @@ int    tag_get_count() {
 }
 
 HSTag* find_tag(const char* name) {
-    for (auto t : *global_tags) {
-        if (t->name == name) {
-            return &* t;
-        }
-    }
-    return nullptr;
+    return global_tags->find(name);
 }
 
 HSTag* get_tag_by_index(int index) {
     return &* global_tags->byIdx(index);
 }
 
-void tag_force_update_flags() {
-    g_tag_flags_dirty = false;
-    // unset all tags
-    for (auto t : *global_tags) {
-        t->flags = 0;
-    }
-    // update flags
-    for (auto c : Root::common().clients()) {
-        auto client = c.second;
-        TAG_SET_FLAG(client->tag(), TAG_FLAG_USED);
-        if (client->urgent_) {
-            TAG_SET_FLAG(client->tag(), TAG_FLAG_URGENT);
-        }
+int HSTag::flags() const
+{
+    int result = 0;
+    if (clientCounter_ > 0) {
+        result |= TAG_FLAG_USED;
+    }
+    if (urgentCounter_ > 0) {
+        result |= TAG_FLAG_URGENT;
     }
+    return result;
 }
 
-void tag_update_flags() {
-    if (g_tag_flags_dirty) {
-        tag_force_update_flags();
+void HSTag::countClientFlags(bool urgent, int delta)
+{
+    clientCounter_ += delta;
+    if (urgent) {
+        urgentCounter_ += delta;
     }
 }
 
-void tag_set_flags_dirty() {
-    g_tag_flags_dirty = true;
-    hook_emit({"tag_flags"});
+/**
+ * @brief emit the tag_flags hook if the flags of some tag have changed.
+ * If forceHook is set, the hook is emitted in any case, e.g. because the
+ * order of the tags changed, which panels also need to know about.
+ */
+void tag_update_flags(bool forceHook) {
+    bool changed = false;
+    for (auto t : *global_tags) {
+        int flags = t->flags();
+        if (flags != t->publishedFlags_) {
+            t->publishedFlags_ = flags;
+            changed = true;
+        }
+    }
+    if (changed || forceHook) {
+        hook_emit({"tag_flags"});
+    }
 }
 
 //! close the focused client or remove if the frame is empty
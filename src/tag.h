@@ -1,6 +1,7 @@
 #ifndef __HERBSTLUFT_TAG_H_
 #define __HERBSTLUFT_TAG_H_
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -9,15 +10,13 @@
 #include "object.h"
 #include "signal.h"
 
-#define TAG_SET_FLAG(tag, flag) \
-    ((tag)->flags |= (flag))
-
 enum {
     TAG_FLAG_URGENT = 0x01, // is there a urgent window?
     TAG_FLAG_USED   = 0x02, // the opposite of empty
 };
 
 class Client;
+class ClientEdgeIndex;
 class Completion;
 class FrameLeaf;
 class FrameTree;
@@ -41,12 +40,21 @@ public:
     DynAttribute_<int> curframe_windex;
     DynAttribute_<int> curframe_wcount;
     DynChild_<Client> focused_client;
-    int             flags;
+    //! the TAG_FLAG_* values of this tag
+    int flags() const;
+    //! count a client entering (delta = 1) or leaving (delta = -1) the tag
+    void countClientFlags(bool urgent, int delta);
+    //! the flags announced by the last tag_flags hook
+    int publishedFlags_ = 0;
+    //! the minimized clients of this tag, by the time of their minimization
+    std::map<long long int, Client*> minimizedClients_;
     std::vector<Client*> floating_clients_; //! the clients in floating mode
     // the tag must assert that the floating layer is only
     // focused if this tag hasVisibleFloatingClients()
     size_t               floating_clients_focus_; //! focus in the floating clients
     std::shared_ptr<Stack> stack;
+    //! the geometries of the clients on this tag
+    std::shared_ptr<ClientEdgeIndex> edgeIndex;
     void setIndexAttribute(unsigned long new_index) override;
     bool focusClient(Client* client);
     void applyClientState(Client* client);
@@ -93,6 +101,9 @@ private:
     int computeFrameCount();
     //! get the number of urgent clients on this tag
     int countUrgentClients();
+    //! the number of clients and urgent clients for flags()
+    int clientCounter_ = 0;
+    int urgentCounter_ = 0;
     TagManager* tags_;
     Settings* settings_;
 };
@@ -101,9 +112,7 @@ private:
 HSTag* find_tag(const char* name);
 HSTag* get_tag_by_index(int index);
 int    tag_get_count();
-void tag_force_update_flags();
-void tag_update_flags();
-void tag_set_flags_dirty();
+void tag_update_flags(bool forceHook = false);
 
 #endif
 
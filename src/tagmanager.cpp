@@ -1,12 +1,15 @@
 #include "tagmanager.h"
 
 #include <memory>
+#include <sstream>
 
 #include "argparse.h"
 #include "client.h"
 #include "command.h"
 #include "completion.h"
 #include "ewmh.h"
+#include "frameparser.h"
+#include "frametree.h"
 #include "globals.h"
 #include "ipc-protocol.h"
 #include "monitor.h"
@@ -14,6 +17,8 @@
 #include "utils.h"
 
 using std::function;
+using std::make_pair;
+using std::pair;
 using std::string;
 using std::shared_ptr;
 using std::vector;
@@ -32,7 +37,8 @@ TagManager::TagManager()
     indicesChanged.connect([](){
         Ewmh::get().updateDesktopNames();
         Ewmh::get().updateCurrentDesktop();
-        tag_set_flags_dirty();
+        // the flags did not change, but their order
+        tag_update_flags(true);
     });
 
     setDoc(
@@ -66,12 +72,11 @@ string TagManager::str(HSTag* tag)
 }
 
 HSTag* TagManager::find(const string& name) {
-    for (auto t : *this) {
-        if (t->name == name) {
-            return t;
-        }
+    auto it = tagsByName_.find(name);
+    if (it == tagsByName_.end()) {
+        return {};
     }
-    return {};
+    return it->second;
 }
 
 void TagManager::completeEntries(Completion& complete) {
@@ -103,7 +108,10 @@ HSTag* TagManager::add_tag(const string& name) {
     }
     HSTag* tag = new HSTag(name, this, settings_);
     addIndexed(tag);
+    tagsByName_[name] = tag;
     tag->name.changed().connect([this,tag]() {
+        tagsByName_.erase(tag->oldName_);
+        tagsByName_[tag->name()] = tag;
         this->onTagRename(tag);
         tag->oldName_ = tag->name;
     });
@@ -111,7 +119,7 @@ HSTag* TagManager::add_tag(const string& name) {
 
     Ewmh::get().updateDesktops();
     Ewmh::get().updateDesktopNames();
-    tag_set_flags_dirty();
+    tag_update_flags();
     return tag;
 }
 
@@ -131,6 +139,64 @@ void TagManager::addCommand(CallOrComplete invoc)
     });
 }
 
+//! print the layouts of all tags, one line 'TAG: LAYOUT' per tag
+int TagManager::dumpLayoutsCommand(Output output)
+{
+    for (HSTag* tag : *this) {
+        output << tag->name() << ": ";
+        FrameTree::dump(tag->frame->root_, output);
+        output << "\n";
+    }
+    return HERBST_EXIT_SUCCESS;
+}
+
+/**
+ * @brief Load the layouts of many tags at once, in the format of
+ * dump_layouts. Missing tags are created. Nothing is changed if some
+ * layout has a syntax error.
+ */
+void TagManager::loadLayoutsCommand(CallOrComplete invoc)
+{
+    string snapshot;
+    ArgParse().mandatory(snapshot)
+            .command(invoc, [&](Output output) {
+        vector<pair<string, shared_ptr<FrameParser>>> layouts;
+        size_t lineNumber = 0;
+        std::istringstream lines(snapshot);
+        string line;
+        while (std::getline(lines, line)) {
+            lineNumber++;
+            if (line.find_first_not_of(" \t\r") == string::npos) {
+                continue;
+            }
+            // a layout never contains ": ", so the tag name
+            // ends at the last occurrence of it
+            size_t separator = line.rfind(": ");
+            if (separator == string::npos || separator == 0) {
+                output.perror() << "Line " << lineNumber
+                                << ": Expected \"TAG: LAYOUT\"\n";
+                return HERBST_INVALID_ARGUMENT;
+            }
+            auto parser = FrameTree::parseSnapshotLayout(line.substr(separator + 2),
+                                                         lineNumber, output);
+            if (!parser) {
+                return HERBST_INVALID_ARGUMENT;
+            }
+            layouts.push_back(make_pair(line.substr(0, separator), parser));
+        }
+        for (const auto& entry : layouts) {
+            HSTag* tag = find(entry.first);
+            if (!tag) {
+                tag = add_tag(entry.first);
+                hook_emit({"tag_added", tag->name});
+            }
+            tag->frame->loadLayout(entry.second->root_);
+        }
+        tag_update_flags(); // we probably changed some window positions
+        return HERBST_EXIT_SUCCESS;
+    });
+}
+
 void TagManager::mergeTagCommand(CallOrComplete invoc) {
     HSTag* tagToRemove = nullptr;
     HSTag* targetTag = monitors_->focus()->tag;
@@ -177,11 +243,12 @@ bool TagManager::mergeTag(HSTag* tagToRemove, HSTag* targetTag)
 
     // Remove tag
     string removedName = tagToRemove->name;
+    tagsByName_.erase(removedName);
     removeIndexed(index_of(tagToRemove));
     Ewmh::get().updateCurrentDesktop();
     Ewmh::get().updateDesktops();
     Ewmh::get().updateDesktopNames();
-    tag_set_flags_dirty();
+    tag_update_flags();
     hook_emit({"tag_removed", removedName, targetTag->name()});
     return true;
 }
@@ -298,7 +365,7 @@ void TagManager::moveClient(Client* client, HSTag* target, string frameIndex, bo
     if (!monitor_source && monitor_target) {
         client->set_visible(!client->minimized_());
     }
-    tag_set_flags_dirty();
+    tag_update_flags();
 }
 
 void TagManager::tag_move_window_command(CallOrComplete invoc) {
@@ -1,6 +1,8 @@
 #ifndef __HLWM_TAGMANAGER_H_
 #define __HLWM_TAGMANAGER_H_
 
+#include <unordered_map>
+
 #include "byname.h"
 #include "commandio.h"
 #include "indexingobject.h"
@@ -37,6 +39,8 @@ public:
     bool mergeTag(HSTag* tagToRemove, HSTag* targetTag);
     void addCommand(CallOrComplete invoc);
     void tag_rename_command(CallOrComplete invoc);
+    int dumpLayoutsCommand(Output output);
+    void loadLayoutsCommand(CallOrComplete invoc);
     void tag_move_window_command(CallOrComplete invoc);
     void tag_move_window_by_index_command(CallOrComplete invoc);
     int floatingCmd(Input input, Output output);
@@ -60,6 +64,7 @@ private:
     std::function<void(Completion&)> frameCompletion(FrameCompleter completer);
     void onTagRename(HSTag* tag);
     ByName by_name_;
+    std::unordered_map<std::string, HSTag*> tagsByName_;
     MonitorManager* monitors_ = {}; // circular dependency
     Settings* settings_;
 };
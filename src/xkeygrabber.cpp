@@ -14,7 +14,10 @@ XKeyGrabber::XKeyGrabber() {
     updateNumlockMask();
 }
 
-//! Obtains the current numlock mask value
+/*!
+ * Obtains the current numlock mask value. This requires a round trip to the
+ * X server, so it should only be called when the modifier mapping changed.
+ */
 void XKeyGrabber::updateNumlockMask() {
     XModifierKeymap *modmap;
 
@@ -50,19 +53,70 @@ KeyCombo XKeyGrabber::xEventToKeyCombo(XKeyEvent* ev) const {
 
 //! Grabs the given key combo
 void XKeyGrabber::grabKeyCombo(const KeyCombo& keyCombo) {
-    changeGrabbedState(keyCombo, true);
+    if (grabbedKeys_.insert(keyCombo).second) {
+        changeGrabbedState(keyCombo, true);
+    }
 }
 
 //! Ungrabs the given key combo
 void XKeyGrabber::ungrabKeyCombo(const KeyCombo& keyCombo) {
-    changeGrabbedState(keyCombo, false);
+    if (grabbedKeys_.erase(keyCombo) > 0) {
+        changeGrabbedState(keyCombo, false);
+    }
+}
+
+/*!
+ * Makes the given key combos the grabbed ones. Only the difference to the
+ * currently grabbed combos is sent to the X server, and all requests are
+ * flushed at once at the end.
+ */
+void XKeyGrabber::setGrabbedKeys(const KeyComboSet& keyCombos) {
+    for (auto it = grabbedKeys_.begin(); it != grabbedKeys_.end(); ) {
+        if (keyCombos.find(*it) == keyCombos.end()) {
+            changeGrabbedState(*it, false);
+            it = grabbedKeys_.erase(it);
+        } else {
+            it++;
+        }
+    }
+    for (const auto& keyCombo : keyCombos) {
+        if (grabbedKeys_.insert(keyCombo).second) {
+            changeGrabbedState(keyCombo, true);
+        }
+    }
+    XFlush(g_display);
+}
+
+/*!
+ * Grabs all currently grabbed key combos again. This is required after
+ * the keyboard or modifier mapping changed.
+ */
+void XKeyGrabber::regrabAll() {
+    XUngrabKey(g_display, AnyKey, AnyModifier, g_root);
+    for (const auto& keyCombo : grabbedKeys_) {
+        changeGrabbedState(keyCombo, true);
+    }
+    XFlush(g_display);
 }
 
 //! Removes all grabbed keys (without knowing them)
 void XKeyGrabber::ungrabAll() {
+    grabbedKeys_.clear();
     XUngrabKey(g_display, AnyKey, AnyModifier, g_root);
 }
 
+/*!
+ * Grabs the entire keyboard, e.g. while waiting for the remaining combos of
+ * a key chain
+ */
+void XKeyGrabber::grabKeyboard() {
+    XGrabKeyboard(g_display, g_root, True, GrabModeAsync, GrabModeAsync, CurrentTime);
+}
+
+void XKeyGrabber::ungrabKeyboard() {
+    XUngrabKeyboard(g_display, CurrentTime);
+}
+
 //! Grabs/ungrabs a given key combo
 void XKeyGrabber::changeGrabbedState(const KeyCombo& keyCombo, bool grabbed) {
     // List of ignored modifiers (key combo will be grabbed for each of them):
@@ -2,6 +2,7 @@
 
 #include <X11/Xlib.h>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "keycombo.h"
@@ -11,10 +12,16 @@
  * maintains knowledge of the current keyboard layout
  *
  * Expects to be notified about keyboard mapping changes so that it can keep
- * track of the current numlock mask value.
+ * track of the current numlock mask value. The modifier mapping is only
+ * fetched from the server on such notifications.
+ *
+ * The set of grabbed key combos is tracked, such that a new grab set can be
+ * applied by only sending the difference to the X server.
  */
 class XKeyGrabber {
 public:
+    using KeyComboSet = std::unordered_set<KeyCombo, KeyCombo::Hash>;
+
     XKeyGrabber();
 
     void updateNumlockMask();
@@ -23,7 +30,15 @@ public:
 
     void grabKeyCombo(const KeyCombo& keyCombo);
     void ungrabKeyCombo(const KeyCombo& keyCombo);
+    void setGrabbedKeys(const KeyComboSet& keyCombos);
+    void regrabAll();
     void ungrabAll();
+    void grabKeyboard();
+    void ungrabKeyboard();
+
+    const KeyComboSet& grabbedKeys() const {
+        return grabbedKeys_;
+    }
 
     // TODO: This is not supposed to exist. It only does as a workaround,
     // because mouse.cpp still wants to know the numlock mask.
@@ -36,6 +51,8 @@ public:
 private:
     void changeGrabbedState(const KeyCombo& keyCombo, bool grabbed);
     unsigned int numlockMask_ = 0;
+    //! the key combos that are currently grabbed
+    KeyComboSet grabbedKeys_;
 
 };
 
@@ -7,6 +7,7 @@
 #include <sys/wait.h>
 #include <iostream>
 #include <memory>
+#include <unordered_set>
 
 #include "client.h"
 #include "clientmanager.h"
@@ -16,11 +17,13 @@
 #include "ewmh.h"
 #include "framedecoration.h"
 #include "frametree.h"
+#include "globalcommands.h"
 #include "hlwmcommon.h"
 #include "ipc-server.h"
 #include "keymanager.h"
 #include "layout.h"
 #include "monitor.h"
+#include "monitordetection.h"
 #include "monitormanager.h"
 #include "mousemanager.h"
 #include "panelmanager.h"
@@ -77,6 +80,8 @@ XMainLoop::XMainLoop(XConnection& X, Root* root)
     handlerTable_[ UnmapNotify       ] = EH(&XMainLoop::unmapnotify);
     handlerTable_[ SelectionClear    ] = EH(&XMainLoop::selectionclear);
 
+    randrEventBase_ = MonitorDetection::selectRandrEvents(X_);
+
     // get events from hlwm:
     root_->monitors->dropEnterNotifyEvents
             .connect(this, &XMainLoop::dropEnterNotifyEvents);
@@ -92,9 +97,10 @@ void XMainLoop::scanExistingClients() {
     auto clientmanager = root_->clients();
     auto& initialEwmhState = root_->ewmh_.initialState();
     auto& originalClients = initialEwmhState.original_client_list_;
-    auto isInOriginalClients = [&originalClients] (Window win) {
-        return originalClients.end()
-            != std::find(originalClients.begin(), originalClients.end(), win);
+    std::unordered_set<Window> originalClientSet(originalClients.begin(),
+                                                 originalClients.end());
+    auto isInOriginalClients = [&originalClientSet] (Window win) {
+        return originalClientSet.count(win) > 0;
     };
     auto findTagForWindow = [this](Window win) -> function<void(ClientChanges&)> {
             if (!root_->globals.importTagsFromEwmh) {
@@ -112,6 +118,12 @@ void XMainLoop::scanExistingClients() {
                 }
             };
     };
+    // do not apply the layout for every single client, but only
+    // once for every monitor when all clients have been adopted.
+    // The attributes and the window type are still read with one
+    // blocking request each per window, because Xlib has no public
+    // API for collecting several replies at once.
+    root_->monitors->lock();
     for (auto win : X_.queryTree(X_.root())) {
         if (!XGetWindowAttributes(X_.display(), win, &wa) || wa.override_redirect)
         {
@@ -125,13 +137,13 @@ void XMainLoop::scanExistingClients() {
         if (root_->ewmh_.isOwnWindow(win)) {
             continue;
         }
-        if (root_->ewmh_.getWindowType(win) == NetWmWindowTypeDesktop)
+        int windowType = root_->ewmh_.getWindowType(win);
+        if (windowType == NetWmWindowTypeDesktop)
         {
             DesktopWindow::registerDesktop(win);
-            root_->monitors->restack();
             XMapWindow(X_.display(), win);
         }
-        else if (root_->ewmh_.getWindowType(win) == NetWmWindowTypeDock)
+        else if (windowType == NetWmWindowTypeDock)
         {
             root_->panels->registerPanel(win);
             XSelectInput(X_.display(), win, PropertyChangeMask);
@@ -158,6 +170,7 @@ void XMainLoop::scanExistingClients() {
         XReparentWindow(X_.display(), win, X_.root(), 0,0);
         clientmanager->manage_client(win, true, false, findTagForWindow(win));
     }
+    root_->monitors->unlock();
     root_->monitors->restack();
 }
 
@@ -171,22 +184,73 @@ void XMainLoop::run() {
         // before making the process hang in the `select` call,
         // first collect all zombies:
         collectZombies();
+        // publish what has changed while handling the previous events
+        root_->global_commands->emitTagStatusHooks();
+        root_->ewmh_.flush();
         // set the the `select` sets:
         FD_ZERO(&in_fds);
         FD_SET(x11_fd, &in_fds);
-        // wait for an event or a signal
-        select(x11_fd + 1, &in_fds, nullptr, nullptr, nullptr);
+        // wait for an event or a signal, or until the next frame
+        // of a mouse drag, the next monitor detection, or the abort
+        // of a pending key chain is due
+        struct timeval timeout = {};
+        auto dragTimeout = root_->mouse->dragFrameTimeout();
+        auto nextTimeout = dragTimeout;
+        auto detectionTimeout = root_->monitors->monitorDetectionTimeout();
+        if (detectionTimeout && (!nextTimeout || *detectionTimeout < *nextTimeout)) {
+            nextTimeout = detectionTimeout;
+        }
+        auto chainTimeout = root_->keys->keyChainTimeout();
+        if (chainTimeout && (!nextTimeout || *chainTimeout < *nextTimeout)) {
+            nextTimeout = chainTimeout;
+        }
+        if (nextTimeout) {
+            timeout.tv_sec = nextTimeout->count() / 1000000;
+            timeout.tv_usec = nextTimeout->count() % 1000000;
+        }
+        select(x11_fd + 1, &in_fds, nullptr, nullptr,
+               nextTimeout ? &timeout : nullptr);
         // if `select` was interrupted by a signal, then it was maybe SIGCHLD
         collectZombies();
         if (aboutToQuit_) {
             break;
         }
+        if (dragTimeout) {
+            root_->mouse->applyPendingMotion(false);
+            root_->watchers->scanForChanges();
+        }
+        if (detectionTimeout) {
+            root_->monitors->detectMonitorsIfDue();
+            root_->watchers->scanForChanges();
+        }
+        if (chainTimeout) {
+            root_->keys->leaveChainIfDue();
+        }
         XSync(X_.display(), False);
         while (XQLength(X_.display())) {
             XNextEvent(X_.display(), &event);
-            EventHandler handler = handlerTable_[event.type];
-            if (handler != nullptr) {
-                (this ->* handler)(&event);
+            switch (event.type) {
+                case ButtonPress:
+                case ButtonRelease:
+                case KeyPress:
+                case KeyRelease:
+                    // bindings have to see the latest pointer position
+                    // of a drag. All other events (in particular
+                    // configure, expose, and property events) do not
+                    // depend on it, so the pending motion stays pending
+                    // until the next frame is due.
+                    root_->mouse->applyPendingMotion(true);
+                    break;
+                default:
+                    break;
+            }
+            if (event.type < LASTEvent) {
+                EventHandler handler = handlerTable_[event.type];
+                if (handler != nullptr) {
+                    (this ->* handler)(&event);
+                }
+            } else {
+                randrnotify(&event);
             }
             root_->watchers->scanForChanges();
             XSync(X_.display(), False);
@@ -381,11 +445,7 @@ void XMainLoop::configurenotify(XConfigureEvent* event) {
     if (event->window == X_.root()) {
         root_->panels->rootWindowChanged(event->width, event->height);
         if (root_->settings->auto_detect_monitors()) {
-            Input input = Input("detect_monitors");
-            std::ostringstream void_output;
-            // discard output, but forward errors to std:cerr
-            OutputChannels channels("", void_output, std::cerr);
-            root_->monitors->detectMonitorsCommand(input, channels);
+            root_->monitors->scheduleMonitorDetection();
         }
     } else {
         Rectangle geometry = { event->x, event->y, event->width, event->height };
@@ -502,9 +562,10 @@ void XMainLoop::keypress(XKeyEvent* event) {
 }
 
 void XMainLoop::mappingnotify(XMappingEvent* ev) {
-    // regrab when keyboard map changes
+    // regrab when keyboard map changes. The numlock mask is only
+    // determined again in this case.
     XRefreshKeyboardMapping(ev);
-    if(ev->request == MappingKeyboard) {
+    if (ev->request == MappingKeyboard || ev->request == MappingModifier) {
         root_->keys()->regrabAll();
         //TODO: mouse_regrab_all();
     }
@@ -606,6 +667,7 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
             //        client->window_id_str().c_str(),
             //        ev->atom,
             //        atomname);
+            client->propertyChanged(ev->atom);
             if (ev->atom == XA_WM_HINTS) {
                 client->update_wm_hints();
             } else if (ev->atom == XA_WM_NORMAL_HINTS) {
@@ -635,6 +697,14 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
     }
 }
 
+void XMainLoop::randrnotify(XEvent* event) {
+    if (MonitorDetection::isRandrChange(randrEventBase_, event)
+        && root_->settings->auto_detect_monitors())
+    {
+        root_->monitors->scheduleMonitorDetection();
+    }
+}
+
 void XMainLoop::unmapnotify(XUnmapEvent* event) {
     HSDebug("name is: UnmapNotify for window=0x%lx and event=0x%lx\n", event->window, event->event);
     if (event->window == event->event) {
@@ -675,6 +745,10 @@ IpcServer::CallResult XMainLoop::callCommand(const vector<string>& call)
     IpcServer::CallResult result;
     OutputChannels channels(commandName, output, error);
     result.exitCode = Commands::call(input, channels);
+    // the caller may inspect the ewmh properties and the hooks as soon
+    // as it receives the result, so they have to be up to date by then
+    Root::get()->global_commands->emitTagStatusHooks();
+    Ewmh::get().flush();
     result.output = output.str();
     result.error = error.str();
     return result;
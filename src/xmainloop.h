@@ -30,6 +30,7 @@ private:
     Root* root_;
     bool aboutToQuit_;
     EventHandler handlerTable_[LASTEvent];
+    int randrEventBase_; //! the RandR event base or -1
 
     void collectZombies();
     // event handlers
@@ -51,6 +52,7 @@ private:
     void selectionclear(XSelectionClearEvent* event);
     void propertynotify(XPropertyEvent* event);
     void unmapnotify(XUnmapEvent* event);
+    void randrnotify(XEvent* event);
 
     bool duringEnterNotify_ = false; //! whether we are in enternotify()
 
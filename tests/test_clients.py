@@ -1,5 +1,6 @@
 import pytest
 import random
+from Xlib import Xatom
 from conftest import PROCESS_SHUTDOWN_TIME
 from herbstluftwm.types import Rectangle
 
@@ -138,6 +139,21 @@ def test_urgent_jumpto_resets_urgent_flag(hlwm, x11, explicit_winid):
     assert hlwm.get_attr('clients.focus.urgent') == 'false'
 
 
+def test_jumpto_urgent_picks_the_most_recently_urgent(hlwm, x11):
+    hlwm.create_client()  # dummy client that gets the focus
+    clients = [x11.create_client() for _ in range(3)]
+    for window, _ in clients:
+        x11.make_window_urgent(window)
+    x11.sync_with_hlwm()
+
+    for _, winid in reversed(clients):
+        hlwm.call('jumpto urgent')
+        assert hlwm.attr.clients.focus.winid() == winid
+
+    hlwm.call_xfail('jumpto urgent') \
+        .expect_stderr('No client is urgent')
+
+
 @pytest.mark.parametrize("arg,expected_idx", [
     ('longest-minimized', 0),
     ('last-minimized', -1),
@@ -178,6 +194,23 @@ def test_jumpto_longest_minimized_last_minimized(hlwm, noop, arg, expected_idx):
     assert hlwm.attr.clients.focus.minimized() is False
 
 
+def test_jumpto_last_minimized_after_closing(hlwm, x11):
+    clients = [x11.create_client() for _ in range(3)]
+    for _, winid in clients:
+        hlwm.attr.clients[winid].minimized = True
+
+    # remove the most recently minimized client
+    clients[2][0].destroy()
+    x11.sync_with_hlwm()
+
+    hlwm.call('jumpto last-minimized')
+    assert hlwm.attr.clients.focus.winid() == clients[1][1]
+    hlwm.call('jumpto last-minimized')
+    assert hlwm.attr.clients.focus.winid() == clients[0][1]
+    hlwm.call_xfail('jumpto last-minimized') \
+        .expect_stderr('No client is minimized')
+
+
 def test_minimized_client_completions(hlwm):
     assert 'last-minimized' in hlwm.complete('jumpto')
     assert 'longest-minimized' in hlwm.complete('jumpto')
@@ -251,6 +284,21 @@ def test_client_wm_class_none(hlwm, x11):
     assert hlwm.get_attr('clients.{}.class'.format(winid)) == ''
 
 
+def test_client_property_changes_after_managing(hlwm, x11):
+    win, winid = x11.create_client(pid=2342, wm_class=('myinst', 'myclass'))
+    client = 'clients.{}.'.format(winid)
+    assert hlwm.get_attr(client + 'class') == 'myclass'
+
+    win.set_wm_class('otherinst', 'otherclass')
+    win.change_property(x11.display.intern_atom('_NET_WM_PID'),
+                        Xatom.CARDINAL, 32, [4321])
+    x11.sync_with_hlwm()
+
+    assert hlwm.get_attr(client + 'instance') == 'otherinst'
+    assert hlwm.get_attr(client + 'class') == 'otherclass'
+    assert int(hlwm.get_attr(client + 'pid')) == 4321
+
+
 def test_bring_from_different_tag(hlwm, x11):
     _, bonnie = x11.create_client()
     hlwm.call('true')
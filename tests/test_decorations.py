@@ -349,6 +349,25 @@ def test_decoration_tab_title_update(hlwm, x11):
     assert x11.decoration_screenshot(win_handles[0]).color_count(text_color) > 5
 
 
+def test_decoration_title_update_on_invisible_tag(hlwm, x11):
+    text_color = (212, 189, 140)
+    hlwm.attr.theme.title_color = RawImage.rgb2string(text_color)
+    hlwm.attr.theme.title_height = 20
+    hlwm.call('add othertag')
+    winhandle, winid = x11.create_client()
+    x11.set_window_title(winhandle, '')
+    hlwm.call('move othertag')
+    assert x11.decoration_screenshot(winhandle).color_count(text_color) == 0
+
+    # change the title while the tag is not visible
+    x11.set_window_title(winhandle, 'SOMETHING')
+    assert hlwm.attr.clients[winid].title() == 'SOMETHING'
+
+    # the title must be drawn once the tag is shown
+    hlwm.call('use othertag')
+    assert x11.decoration_screenshot(winhandle).color_count(text_color) > 5
+
+
 @pytest.mark.parametrize("running_clients_num", [4])
 def test_decoration_click_changes_tab(hlwm, mouse, running_clients, running_clients_num):
     hlwm.call(['load', '(clients max:0 {})'.format(' '.join(running_clients))])
@@ -68,9 +68,12 @@ classname2examplepath = [
     ('FrameLeaf', lambda _: 'tags.0.tiling.root'),
     ('FrameSplit', create_frame_split),
     ('HSTag', create_tag_with_all_links),
+    ('KeyManager', lambda _: 'keys'),
     ('Monitor', lambda _: 'monitors.0'),
     ('MonitorManager', lambda _: 'monitors'),
+    ('MouseManager', lambda _: 'mouse'),
     ('Panel', create_panel),
+    ('PropertyPublisher', lambda _: 'ewmh'),
     ('Root', lambda _: ''),
     ('Settings', lambda _: 'settings'),
     ('TagManager', lambda _: 'tags'),
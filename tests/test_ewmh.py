@@ -148,6 +148,29 @@ def test_tags_restored_after_wmexec(hlwm, hlwm_process):
         assert hlwm.get_attr(f'tags.{idx}.name') == name
 
 
+def test_clients_adopted_after_wmexec(hlwm, hlwm_process):
+    hlwm.call('add othertag')
+    clients = hlwm.create_clients(6)
+    for _ in range(0, 3):
+        hlwm.call(['move', 'othertag'])
+    tags = {winid: hlwm.get_attr(f'clients.{winid}.tag') for winid in clients}
+
+    # Restart hlwm:
+    p = hlwm.unchecked_call(['wmexec', hlwm_process.bin_path, '--verbose'],
+                            read_hlwm_output=False)
+    assert p.returncode == 0
+    hlwm_process.read_and_echo_output(until_stdout='hlwm started')
+
+    managed = [c for c in hlwm.list_children('clients') if c != 'focus']
+    assert sorted(managed) == sorted(clients)
+    for winid, tag in tags.items():
+        assert hlwm.get_attr(f'clients.{winid}.tag') == tag
+    # the layout was applied to the visible clients
+    visible = [w for w in clients if tags[w] == 'default']
+    geometries = [hlwm.attr.clients[w].content_geometry() for w in visible]
+    assert len(set(geometries)) == len(visible)
+
+
 @pytest.mark.parametrize('desktops,client2desktop', [
     (2, [0, 1]),
     (2, [None, 1]),  # client without index set
@@ -527,3 +550,56 @@ def test_cancel_drag(hlwm, x11):
     x11.sync_with_hlwm()
 
     assert not is_dragging()
+
+
+def test_client_list_stacking_written_once_per_command(hlwm, x11, x11_connection):
+    hlwm.call('rule floating=on')
+    clients = [x11.create_client()[0] for _ in range(0, 3)]
+    winids = [x11.winid_str(c) for c in clients]
+    # the last created client is on top
+    expected_stack = [c.id for c in clients]
+    assert x11.get_property('_NET_CLIENT_LIST_STACKING') == expected_stack
+
+    # count the writes of _NET_CLIENT_LIST_STACKING on a separate connection
+    stacking_atom = x11_connection.intern_atom('_NET_CLIENT_LIST_STACKING')
+    root = x11_connection.screen().root
+    root.change_attributes(event_mask=X.PropertyChangeMask)
+    x11_connection.sync()
+
+    def count_stacking_writes():
+        hlwm.call('true')
+        x11_connection.sync()
+        count = 0
+        while x11_connection.pending_events() > 0:
+            ev = x11_connection.next_event()
+            if ev.type == X.PropertyNotify and ev.atom == stacking_atom:
+                count += 1
+        return count
+
+    # raising the topmost client does not change anything
+    hlwm.call(['raise', winids[2]])
+    assert count_stacking_writes() == 0
+
+    # restacking multiple times within one command results in one write
+    hlwm.call(['chain', ',', 'raise', winids[0], ',', 'raise', winids[1]])
+    assert count_stacking_writes() == 1
+    expected_stack = [clients[i].id for i in [2, 0, 1]]
+    assert x11.get_property('_NET_CLIENT_LIST_STACKING') == expected_stack
+
+
+def test_unchanged_properties_are_not_written(hlwm, x11):
+    names_before = x11.get_property('_NET_DESKTOP_NAMES')
+    writes = int(hlwm.attr.ewmh.writes())
+    suppressed = int(hlwm.attr.ewmh.writes_suppressed())
+
+    # the desktop names change twice, but are identical at the end
+    hlwm.call('chain , rename default foo , rename foo default')
+
+    assert x11.get_property('_NET_DESKTOP_NAMES') == names_before
+    assert int(hlwm.attr.ewmh.writes()) == writes
+    assert int(hlwm.attr.ewmh.writes_suppressed()) >= suppressed + 2
+
+    hlwm.call('rename default foo')
+
+    assert int(hlwm.attr.ewmh.writes()) == writes + 1
+    assert x11.get_property('_NET_DESKTOP_NAMES') != names_before
@@ -86,6 +86,37 @@ def test_directional_shift_right(hlwm, x11, start_y_rel, hits_obstacle):
     assert x + winwidth + snap_gap == width
 
 
+@pytest.mark.parametrize('obstacle_change', ['move', 'other_tag', 'destroy'])
+def test_directional_shift_after_obstacle_changed(hlwm, x11, obstacle_change):
+    hlwm.call('attr tags.focus.floating on')
+    hlwm.call('attr theme.border_width 0')
+    snap_gap = 8
+    hlwm.call(f'attr settings.snap_gap {snap_gap}')
+    width = int(hlwm.call('monitor_rect').stdout.split(' ')[2])
+    handle, winid = x11.create_client(geometry=(0, 100, 100, 100))
+    obstacle_handle, obstacle = x11.create_client(geometry=(400, 100, 100, 100))
+    hlwm.call(['jumpto', winid])
+    hlwm.call('shift right')
+    assert x11.get_absolute_top_left(handle) == (400 - snap_gap - 100, 100)
+
+    # change the obstacle such that it is out of the way
+    if obstacle_change == 'move':
+        hlwm.attr.clients[obstacle].floating_geometry = \
+            Rectangle(x=400, y=300, width=100, height=100)
+    elif obstacle_change == 'other_tag':
+        hlwm.call('add othertag')
+        hlwm.call(['jumpto', obstacle])
+        hlwm.call(['move', 'othertag'])
+    elif obstacle_change == 'destroy':
+        obstacle_handle.destroy()
+        x11.sync_with_hlwm()
+    hlwm.call(['jumpto', winid])
+    hlwm.call('shift right')
+
+    # then the client is shifted to the monitor edge
+    assert x11.get_absolute_top_left(handle) == (width - snap_gap - 100, 100)
+
+
 @pytest.mark.parametrize('command', ['shift', 'resize'])
 @pytest.mark.parametrize('direction', ['left', 'up'])
 @pytest.mark.parametrize('put_obstacle', [True, False])
@@ -33,6 +33,55 @@ def test_tag_status_multi_monitor(hlwm):
     assert hlwm.call('tag_status 1').stdout == '\t-default\t#othermon\t.d1\t.d2\t.d3\t'
 
 
+def test_tag_flags_hook_only_on_changes(hlwm, hc_idle):
+    hlwm.call('add othertag')
+    hlwm.create_clients(3)
+    hc_idle.hooks()  # clear hooks
+
+    # the first client makes the tag non-empty, the second does not
+    # change the flags anymore
+    hlwm.call('move othertag')
+    assert ['tag_flags'] in hc_idle.hooks()
+    hlwm.call('move othertag')
+    assert ['tag_flags'] not in hc_idle.hooks()
+    assert hlwm.call('tag_status').stdout == '\t#default\t:othertag\t'
+
+    hlwm.call('load othertag "(clients max:0)"')
+    assert ['tag_flags'] not in hc_idle.hooks()
+
+
+@pytest.mark.parametrize("command", [
+    'set_attr tags.0.index 1',
+    'merge_tag tag2',
+])
+def test_tag_flags_hook_on_tag_order_change(hlwm, hc_idle, command):
+    hlwm.call('add tag2')
+    hlwm.call('add tag3')
+    hc_idle.hooks()  # clear hooks
+
+    hlwm.call(command)
+
+    assert ['tag_flags'] in hc_idle.hooks()
+
+
+def test_tag_status_hook(hlwm, hc_idle):
+    hlwm.call('add othertag')
+    hlwm.call('set tag_status_hook on')
+    assert ['tag_status', '0', '#default', '.othertag'] in hc_idle.hooks()
+
+    hlwm.call('use othertag')
+    assert ['tag_status', '0', '.default', '#othertag'] in hc_idle.hooks()
+
+    # an unchanged tag status is not emitted again
+    hlwm.call('use othertag')
+    hlwm.call('true')
+    assert [h for h in hc_idle.hooks() if h[0] == 'tag_status'] == []
+
+    hlwm.call('set tag_status_hook off')
+    hlwm.call('use default')
+    assert [h for h in hc_idle.hooks() if h[0] == 'tag_status'] == []
+
+
 def test_tag_status_completion(hlwm):
     monname = 'monitor_name'
     assert '0' in hlwm.complete('tag_status')
@@ -1,5 +1,6 @@
 import pytest
 import subprocess
+import time
 
 from conftest import PROCESS_SHUTDOWN_TIME
 
@@ -57,6 +58,18 @@ def test_keyunbind_all(hlwm, method, keyboard):
     keyboard.press('Alt+x')  # verify that key got ungrabbed
 
 
+def test_keyunbind_keeps_other_grabs(hlwm, keyboard):
+    hlwm.call('new_attr string my_y_pressed')
+    hlwm.call('keybind x quit')
+    hlwm.call('keybind y set_attr my_y_pressed pressed')
+
+    hlwm.call('keyunbind x')
+    keyboard.press('x')
+    keyboard.press('y')
+
+    assert hlwm.get_attr('my_y_pressed') == 'pressed'
+
+
 def test_keyunbind_nonexistent_binding(hlwm):
     hlwm.call_xfail('keyunbind n') \
         .expect_stderr('keyunbind: Key "n" is not bound\n')
@@ -243,6 +256,28 @@ def test_keys_inactive_on_other_client(hlwm, keyboard):
     assert hlwm.get_attr('clients.focus.pseudotile') == 'true'
 
 
+def test_keymask_switch_focus_repeatedly(hlwm, keyboard):
+    c1, _ = hlwm.create_client()
+    c2, _ = hlwm.create_client()
+    hlwm.call(f'set_attr clients.{c1}.keymask x')
+    hlwm.call(f'set_attr clients.{c2}.keymask y')
+    for k in ['x', 'y']:
+        hlwm.call(f'new_attr int my_{k}_pressed 0')
+        hlwm.call(f'keybind {k} set_attr my_{k}_pressed +=1')
+
+    # every switch reuses the keymasks evaluated before
+    for _ in range(3):
+        hlwm.call(f'jumpto {c1}')
+        keyboard.press('x')
+        keyboard.press('y')
+        hlwm.call(f'jumpto {c2}')
+        keyboard.press('x')
+        keyboard.press('y')
+
+    assert hlwm.get_attr('my_x_pressed') == '3'
+    assert hlwm.get_attr('my_y_pressed') == '3'
+
+
 def test_keymask_type(hlwm):
     hlwm.create_client()
     hlwm.call(['set_attr',
@@ -316,3 +351,122 @@ def test_keybind_unknown_binding(hlwm):
 def test_empty_keysym(hlwm, command):
     hlwm.call_xfail([command, '', 'true']) \
         .expect_stderr('Must not be empty')
+
+
+def test_keybind_mode_list_keybinds(hlwm):
+    hlwm.call('keybind x quit')
+    hlwm.call('keybind --mode=resize h resize left +0.02')
+
+    assert hlwm.call('list_keybinds').stdout == \
+        'x\tquit\n--mode=resize\th\tresize\tleft\t+0.02\n'
+
+
+def test_keybind_mode_switch(hlwm, keyboard):
+    hlwm.call('new_attr string my_x_pressed')
+    hlwm.call('new_attr string my_y_pressed')
+    hlwm.call('keybind x set_attr my_x_pressed pressed')
+    hlwm.call('keybind --mode=other y set_attr my_y_pressed pressed')
+    hlwm.call('keybind --mode=other Escape set_attr keys.mode default')
+    assert hlwm.get_attr('keys.mode') == 'default'
+
+    # the binding of the other mode is not active
+    keyboard.press('y')
+    assert hlwm.get_attr('my_y_pressed') == ''
+
+    hlwm.call('set_attr keys.mode other')
+    keyboard.press('x')
+    keyboard.press('y')
+    assert hlwm.get_attr('my_x_pressed') == ''
+    assert hlwm.get_attr('my_y_pressed') == 'pressed'
+
+    keyboard.press('Escape')
+    assert hlwm.get_attr('keys.mode') == 'default'
+    keyboard.press('x')
+    assert hlwm.get_attr('my_x_pressed') == 'pressed'
+    int(hlwm.get_attr('keys.mode_switch_usec'))
+
+
+def test_keybind_mode_invalid(hlwm):
+    hlwm.call_xfail('set_attr keys.mode foo') \
+        .expect_stderr('no key bindings in mode "foo"')
+    hlwm.call_xfail('keybind --mode= x quit') \
+        .expect_stderr('mode name must not be empty')
+
+
+def test_keyunbind_last_binding_of_active_mode(hlwm):
+    hlwm.call('keybind --mode=other y quit')
+    hlwm.call('set_attr keys.mode other')
+
+    hlwm.call_xfail('keyunbind y') \
+        .expect_stderr('"y" is not bound')
+    hlwm.call('keyunbind --mode=other y')
+
+    assert hlwm.get_attr('keys.mode') == 'default'
+
+
+def test_keychain_trigger(hlwm, keyboard):
+    hlwm.call('new_attr string my_chain')
+    hlwm.call(['keybind', 'Mod1+i 1', 'set_attr', 'my_chain', 'one'])
+    hlwm.call(['keybind', 'Mod1+i 2', 'set_attr', 'my_chain', 'two'])
+
+    # the second key alone does nothing
+    keyboard.press('1')
+    assert hlwm.get_attr('my_chain') == ''
+
+    keyboard.press('Alt+i')
+    keyboard.press('2')
+    assert hlwm.get_attr('my_chain') == 'two'
+
+    keyboard.press('Alt+i')
+    keyboard.press('1')
+    assert hlwm.get_attr('my_chain') == 'one'
+
+
+def test_keychain_abort(hlwm, keyboard):
+    hlwm.call('new_attr string my_chain')
+    hlwm.call(['keybind', 'Mod1+i 1', 'set_attr', 'my_chain', 'one'])
+
+    keyboard.press('Alt+i')
+    keyboard.press('x')  # aborts the chain
+    keyboard.press('1')
+
+    assert hlwm.get_attr('my_chain') == ''
+
+
+def test_keychain_abort_by_escape(hlwm, keyboard):
+    hlwm.call('new_attr string my_chain')
+    hlwm.call(['keybind', 'Mod1+i 1', 'set_attr', 'my_chain', 'one'])
+
+    keyboard.press('Alt+i')
+    keyboard.press('Escape')
+    keyboard.press('1')
+
+    assert hlwm.get_attr('my_chain') == ''
+
+
+def test_keychain_timeout(hlwm, keyboard):
+    hlwm.call('new_attr string my_chain')
+    hlwm.call(['keybind', 'Mod1+i 1', 'set_attr', 'my_chain', 'one'])
+    hlwm.call(['keybind', 'x', 'set_attr', 'my_chain', 'x'])
+    hlwm.call('set keychain_timeout 100')
+
+    keyboard.press('Alt+i')
+    time.sleep(0.5)
+    # the chain was aborted, so x is not swallowed
+    keyboard.press('x')
+
+    assert hlwm.get_attr('my_chain') == 'x'
+
+
+def test_keychain_replaces_prefix(hlwm):
+    hlwm.call('keybind Mod1+i quit')
+    hlwm.call(['keybind', 'Mod1+i 1', 'use_index', '0'])
+    hlwm.call('keybind x close')
+
+    assert hlwm.call('list_keybinds').stdout == \
+        'Mod1+i 1\tuse_index\t0\nx\tclose\n'
+
+    hlwm.call('keybind Mod1+i quit')
+
+    assert hlwm.call('list_keybinds').stdout == \
+        'x\tclose\nMod1+i\tquit\n'
@@ -222,3 +222,161 @@ def test_load_completion(hlwm):
     assert tagname not in hlwm.complete(['load', tagname])
     hlwm.command_has_all_args(['load', '(clients ...)'])
     hlwm.command_has_all_args(['load', tagname, 'bar'])
+
+
+def test_dump_layouts_load_layouts_round_trip(hlwm):
+    hlwm.call('add othertag')
+    winid, _ = hlwm.create_client()
+    hlwm.call(['load', f'(split vertical:0.3:1 (clients max:0 {winid}) (clients grid:0))'])
+    hlwm.call(['load', 'othertag', '(split horizontal:0.6:0 (clients vertical:0) (clients max:0))'])
+    snapshot = hlwm.call('dump_layouts').stdout
+    assert snapshot.splitlines() == [
+        f'{tag}: ' + hlwm.call(['dump', tag]).stdout
+        for tag in ['default', 'othertag']
+    ]
+
+    hlwm.call(['load', '(clients vertical:0)'])
+    hlwm.call(['load', 'othertag', '(clients max:0)'])
+    hlwm.call(['load_layouts', snapshot])
+
+    assert hlwm.call('dump_layouts').stdout == snapshot
+    assert hlwm.get_attr(f'clients.{winid}.tag') == 'default'
+
+
+def test_load_layouts_creates_missing_tags(hlwm):
+    layout = '(split horizontal:0.5:1 (clients max:0) (clients vertical:0))'
+    hlwm.call(['load_layouts', f'\nnew: tag: {layout}\n\n'])
+
+    assert hlwm.get_attr('tags.by-name.new: tag.name') == 'new: tag'
+    assert hlwm.call(['dump', 'new: tag']).stdout == layout
+
+
+@pytest.mark.parametrize("line,error", [
+    ('no separator', 'Line 2: Expected "TAG: LAYOUT"'),
+    ('othertag: (clients max:0', 'Line 2: Syntax error at 14: Unexpected end of input'),
+])
+def test_load_layouts_error_changes_nothing(hlwm, line, error):
+    hlwm.call('add othertag')
+    hlwm.call('split explode')
+    snapshot_before = hlwm.call('dump_layouts').stdout
+    tag_count = hlwm.get_attr('tags.count')
+
+    snapshot = '\n'.join([
+        'default: (clients grid:0)',
+        line,
+        'newtag: (clients max:0)',
+    ])
+    hlwm.call_xfail(['load_layouts', snapshot]).expect_stderr(error)
+
+    assert hlwm.call('dump_layouts').stdout == snapshot_before
+    assert hlwm.get_attr('tags.count') == tag_count
+
+
+def test_load_layouts_completion(hlwm):
+    hlwm.command_has_all_args(['dump_layouts'])
+    hlwm.command_has_all_args(['load_layouts', 'default: (clients max:0)'])
+
+
+def test_session_round_trip(hlwm):
+    hlwm.call('add othertag')
+    hlwm.call('add_monitor 800x600+800+0 othertag')
+    tiled, _ = hlwm.create_client()
+    floating, _ = hlwm.create_client()
+    hlwm.call(f'set_attr clients.{floating}.floating true')
+    hlwm.call(f'set_attr clients.{floating}.floating_geometry 300x200+40+50')
+    hlwm.call(['load', f'(split vertical:0.3:0 (clients max:0 {tiled}) (clients grid:0))'])
+    hlwm.call(['new_attr', 'string', 'my_note', 'with\ttab\nand newline \\'])
+    hlwm.call('new_attr int tags.by-name.othertag.my_count 42')
+    hlwm.call(f'new_attr bool clients.{floating}.my_flag true')
+    snapshot = hlwm.call('dump_session').stdout
+
+    # change everything that is contained in the snapshot
+    hlwm.call(['load', '(clients max:0)'])
+    hlwm.call('move othertag')
+    hlwm.call(f'set_attr clients.{floating}.floating false')
+    hlwm.call(f'set_attr clients.{floating}.floating_geometry 100x100+0+0')
+    hlwm.call('use othertag')
+    hlwm.call('remove_attr my_note')
+    hlwm.call('set_attr tags.by-name.othertag.my_count 3')
+    assert hlwm.call('dump_session').stdout != snapshot
+
+    hlwm.call(['load_session', snapshot])
+
+    assert hlwm.call('dump_session').stdout == snapshot
+    assert hlwm.get_attr('monitors.0.tag') == 'default'
+    assert hlwm.get_attr('monitors.1.tag') == 'othertag'
+    assert hlwm.get_attr(f'clients.{floating}.floating') == 'true'
+    assert hlwm.get_attr('my_note') == 'with\ttab\nand newline \\'
+    assert hlwm.get_attr('tags.by-name.othertag.my_count') == '42'
+
+
+def test_load_session_creates_tags(hlwm):
+    winid, _ = hlwm.create_client()
+    layout = f'(split horizontal:0.5:1 (clients max:0) (clients vertical:0 {winid}))'
+    hlwm.call(['load_session', '\n'.join([
+        '# a comment',
+        f'tag\tnew\\ttag\t{layout}',
+        '',
+        f'client\t{winid}\tnew\\ttag\tfalse\tfalse\t100x100+0+0',
+        'monitor\t0\tnew\\ttag',
+        'attr\ttags.by-name.new\\ttag.my_count\tint\t3',
+    ])])
+
+    assert hlwm.get_attr('monitors.0.tag') == 'new\ttag'
+    assert hlwm.get_attr('tags.by-name.new\ttag.my_count') == '3'
+    assert hlwm.get_attr(f'clients.{winid}.tag') == 'new\ttag'
+    assert hlwm.call(['dump', 'new\ttag']).stdout == layout
+
+
+def test_load_session_skips_missing_windows_and_monitors(hlwm):
+    proc = hlwm.call(['load_session', '\n'.join([
+        'client\t0x123456\tdefault\ttrue\tfalse\t100x100+0+0',
+        'monitor\t3\tdefault',
+        'attr\tclients.0x123456.my_flag\tbool\ttrue',
+    ])], allowed_stderr=re.compile('load_session: Line [123]: Warning: '))
+    assert 'Line 1: Warning: Unknown window ID 0x123456' in proc.stderr
+    assert 'Line 2: Warning: No such monitor: 3' in proc.stderr
+    assert 'Line 3: Warning: No such object: clients.0x123456' in proc.stderr
+
+
+@pytest.mark.parametrize("line,error", [
+    ('frame\tdefault', 'Line 2: Unknown entry type "frame"'),
+    ('monitor\t0', 'Line 2: Expected 2 fields for "monitor" but got 1'),
+    ('tag\tothertag\t(clients max:0', 'Line 2: Syntax error at 14: Unexpected end of input'),
+    ('monitor\t0\tunknowntag', 'Line 2: Tag "unknowntag" not found'),
+    ('client\t0x123\tdefault\tmaybe\tfalse\t10x10+0+0', 'Line 2: only on/off/true/false'),
+    ('attr\tmy_count\tint\tmany', 'Line 2: "many" is an invalid value for my_count'),
+    ('attr\tmy_count\tfloat\t1.5', 'Line 2: unknown type "float"'),
+    ('attr\tcount\tint\t5', 'Line 2: attribute name must start with "my_"'),
+    ('attr\tmy_attr\tstring\tfive', 'Line 3: attribute "my_attr" has type string instead of int'),
+])
+def test_load_session_error_changes_nothing(hlwm, line, error):
+    hlwm.call('split explode')
+    snapshot_before = hlwm.call('dump_session').stdout
+
+    snapshot = '\n'.join([
+        'tag\tdefault\t(clients grid:0)',
+        line,
+        'attr\tmy_attr\tint\t5',
+    ])
+    hlwm.call_xfail(['load_session', snapshot]).expect_stderr(error)
+
+    assert hlwm.call('dump_session').stdout == snapshot_before
+    assert hlwm.get_attr('tags.count') == '1'
+
+
+def test_load_session_keeps_attribute_type(hlwm):
+    hlwm.call('new_attr int my_count 3')
+
+    hlwm.call_xfail(['load_session', '\n'.join([
+        'tag\tdefault\t(clients grid:0)',
+        'attr\tmy_count\tstring\tfour',
+    ])]).expect_stderr('Line 2: attribute "my_count" has type int instead of string')
+
+    assert hlwm.get_attr('my_count') == '3'
+    assert hlwm.call('dump').stdout == '(clients vertical:0)'
+
+
+def test_session_completion(hlwm):
+    hlwm.command_has_all_args(['dump_session'])
+    hlwm.command_has_all_args(['load_session', 'monitor\t0\tdefault'])
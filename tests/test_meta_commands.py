@@ -201,6 +201,129 @@ def test_disjoin_rects(hlwm):
     assert response == expected
 
 
+def disjoin_rects_reference(rects):
+    """the original queue based implementation of disjoin_rects,
+    for rectangles given as tuples (x, y, width, height)"""
+    def intersection(a, b):
+        x1, y1 = max(a[0], b[0]), max(a[1], b[1])
+        x2 = min(a[0] + a[2], b[0] + b[2])
+        y2 = min(a[1] + a[3], b[1] + b[3])
+        if x2 <= x1 or y2 <= y1:
+            return None
+        return (x1, y1, x2 - x1, y2 - y1)
+
+    def disjoin_from_subset(large, center):
+        br_x, br_y = large[0] + large[2], large[1] + large[3]
+        parts = [
+            (large[0], large[1], large[2], center[1] - large[1]),
+            (large[0], center[1], center[0] - large[0], center[3]),
+            (center[0] + center[2], center[1],
+             br_x - center[0] - center[2], center[3]),
+            (large[0], center[1] + center[3],
+             large[2], br_y - center[1] - center[3]),
+        ]
+        return [p for p in parts if p[2] > 0 and p[3] > 0]
+
+    queue = list(rects)
+    result = []
+    while queue:
+        rect = queue.pop(0)
+        for i, other in enumerate(result):
+            center = intersection(other, rect)
+            if center:
+                result += disjoin_from_subset(other, center)
+                result[i] = center
+                queue += disjoin_from_subset(rect, center)
+                break
+        else:
+            result.append(rect)
+    return result
+
+
+def disjoin_rects_via_command(hlwm, rects):
+    args = ['{}x{}{:+}{:+}'.format(r[2], r[3], r[0], r[1]) for r in rects]
+    result = []
+    for line in hlwm.call(['disjoin_rects'] + args).stdout.splitlines():
+        m = re.match(r'^(\d+)x(\d+)([+-]\d+)([+-]\d+)$', line)
+        w, h, x, y = [int(v) for v in m.groups()]
+        result.append((x, y, w, h))
+    return result
+
+
+def area_by_coverage(pieces, rects):
+    """for every set of rectangles, return the area of the pieces
+    contained in exactly these rectangles"""
+    area = {}
+    for p in pieces:
+        covered_by = []
+        for i, r in enumerate(rects):
+            inside = r[0] <= p[0] and p[0] + p[2] <= r[0] + r[2] \
+                and r[1] <= p[1] and p[1] + p[3] <= r[1] + r[3]
+            disjoint = p[0] + p[2] <= r[0] or r[0] + r[2] <= p[0] \
+                or p[1] + p[3] <= r[1] or r[1] + r[3] <= p[1]
+            # every piece is either inside or outside of each rectangle
+            assert inside or disjoint
+            if inside:
+                covered_by.append(i)
+        key = tuple(covered_by)
+        area[key] = area.get(key, 0) + p[2] * p[3]
+    return area
+
+
+@pytest.mark.parametrize('seed', range(5))
+def test_disjoin_rects_matches_reference(hlwm, seed):
+    import random
+    rng = random.Random(seed)
+    rects = []
+    for _ in range(rng.randint(1, 8)):
+        rects.append((rng.randint(-50, 300), rng.randint(-50, 300),
+                      rng.randint(1, 300), rng.randint(1, 300)))
+    # also include a mirrored output
+    rects.append(rects[0])
+
+    pieces = disjoin_rects_via_command(hlwm, rects)
+
+    for i, a in enumerate(pieces):
+        for b in pieces[i + 1:]:
+            # the pieces are pairwise disjoint
+            assert a[0] + a[2] <= b[0] or b[0] + b[2] <= a[0] \
+                or a[1] + a[3] <= b[1] or b[1] + b[3] <= a[1]
+    # the pieces cover the same area as those of the old implementation,
+    # also when distinguishing by the rectangles containing them
+    assert area_by_coverage(pieces, rects) \
+        == area_by_coverage(disjoin_rects_reference(rects), rects)
+    # the pieces are grouped by the first rectangle containing them
+    first_covering = []
+    for p in pieces:
+        first_covering.append(min(i for i, r in enumerate(rects)
+                                  if r[0] <= p[0] and r[1] <= p[1]
+                                  and p[0] + p[2] <= r[0] + r[2]
+                                  and p[1] + p[3] <= r[1] + r[3]))
+    assert sorted(first_covering) == first_covering
+
+
+def test_disjoin_rects_keeps_order(hlwm):
+    # disjoint rectangles are returned in the given order, such that
+    # e.g. the primary monitor stays the first
+    rects = [(800, 0, 800, 600), (0, 0, 800, 600), (1600, 0, 800, 600)]
+
+    assert disjoin_rects_via_command(hlwm, rects) == rects
+
+
+def test_disjoin_rects_video_wall(hlwm):
+    # a 4x4 video wall of overlapping outputs
+    rects = [(col * 900, row * 500, 1000, 600)
+             for row in range(4) for col in range(4)]
+
+    pieces = disjoin_rects_via_command(hlwm, rects)
+
+    # the borders split the screen into 7x7 cells, and all of them are
+    # covered by a different set of outputs
+    assert len(pieces) == 7 * 7
+    assert area_by_coverage(pieces, rects) \
+        == area_by_coverage(disjoin_rects_reference(rects), rects)
+
+
 def test_attribute_completion(hlwm):
     def complete(partialPath):
         return hlwm.complete('get_attr ' + partialPath,
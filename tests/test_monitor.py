@@ -1,5 +1,8 @@
 import pytest
+import time
 from herbstluftwm.types import Rectangle
+from Xlib import X
+import Xlib
 
 
 def test_default_monitor(hlwm):
@@ -311,6 +314,58 @@ def test_set_monitors_removes_monitors(hlwm, monitor_count_before):
     assert monitors == '0: 100x200+100+0 with tag "default" [FOCUS]\n'
 
 
+def test_set_monitors_only_changes_modified_monitors(hlwm, x11):
+    hlwm.call('add tag2')
+    hlwm.call('set always_show_frame on')
+    hlwm.call('set_monitors 100x200+0+0 100x200+100+0')
+    hlwm.call('set_attr monitors.0.pad_up 10')
+    hlwm.call('set_attr monitors.1.pad_up 20')
+    # move the frame window of the first monitor away. Only
+    # a new layout of the first monitor moves it back.
+    [frame0] = [w for w in x11.get_hlwm_frames()
+                if x11.get_absolute_geometry(w).x < 100]
+    frame0.configure(x=30, y=40)
+    x11.display.sync()
+
+    hlwm.call('set_monitors 100x200+0+0 150x200+100+0')
+
+    assert hlwm.get_attr('monitors.0.geometry') == '100x200+0+0'
+    assert hlwm.get_attr('monitors.1.geometry') == '150x200+100+0'
+    assert hlwm.get_attr('monitors.0.tag') == 'default'
+    assert hlwm.get_attr('monitors.1.tag') == 'tag2'
+    assert hlwm.get_attr('monitors.0.pad_up') == '10'
+    assert hlwm.get_attr('monitors.1.pad_up') == '20'
+    # the first monitor was not laid out again
+    geom = frame0.get_geometry()
+    assert (geom.x, geom.y) == (30, 40)
+
+
+def test_auto_detect_monitors_after_delay(hlwm, x11):
+    hlwm.call('add tag2')
+    hlwm.call('set_monitors 400x300+0+0 400x300+400+0')
+    hlwm.call('set auto_detect_monitors_delay 500')
+    hlwm.call('set auto_detect_monitors on')
+
+    # tell hlwm that the size of the root window changed
+    root = x11.screen.root
+    geom = root.get_geometry()
+    event = Xlib.protocol.event.ConfigureNotify(
+        window=root, event=root, above_sibling=X.NONE,
+        x=0, y=0, width=geom.width, height=geom.height,
+        border_width=0, override=False)
+    root.send_event(event, event_mask=X.StructureNotifyMask)
+    x11.display.sync()
+
+    # the detection does not run immediately
+    assert hlwm.get_attr('monitors.count') == '2'
+    # but after the delay, without any further event
+    for _ in range(50):
+        if hlwm.get_attr('monitors.count') == '1':
+            break
+        time.sleep(0.1)
+    assert hlwm.get_attr('monitors.count') == '1'
+
+
 def test_raise_monitor_completion(hlwm):
     hlwm.call('add tag2')
     hlwm.call('add_monitor 800x600+40+40 tag2 monitor2')
@@ -564,6 +619,32 @@ def test_lock_tag_switch_to_locked(hlwm, locked):
     assert hlwm.attr.monitors.focus.index() == expected_monitor_index
 
 
+def test_tag_on_monitor_after_swap_and_remove(hlwm):
+    hlwm.call('add tag1')
+    hlwm.call('add tag2')
+    hlwm.call('set_monitors 800x600+0+0 800x600+800+0')
+    hlwm.call('set swap_monitors_to_get_tag on')
+    hlwm.attr.monitors[0].tag = 'tag1'
+    hlwm.attr.monitors[1].tag = 'tag2'
+
+    # swap the tags of the two monitors
+    hlwm.call('use tag2')
+    assert hlwm.attr.monitors[0].tag() == 'tag2'
+    assert hlwm.attr.monitors[1].tag() == 'tag1'
+    # the lookup of the monitor showing a tag respects the swap
+    hlwm.call_xfail('add_monitor 100x100+0+0 tag1') \
+        .expect_stderr('Tag "tag1" is already being viewed')
+    hlwm.call_xfail('add_monitor 100x100+0+0 tag2') \
+        .expect_stderr('Tag "tag2" is already being viewed')
+    hlwm.call_xfail('merge_tag tag1') \
+        .expect_stderr('Cannot merge the currently viewed tag')
+
+    # after removing the monitor, its tag is not shown anymore
+    hlwm.call('remove_monitor 1')
+    hlwm.call('merge_tag tag1')
+    assert 'tag1' not in hlwm.list_children('tags.by-name')
+
+
 def test_lock_tag_command_vs_attribute(hlwm):
     hlwm.call('add anothertag')
     hlwm.call('set_monitors 800x600+0+0 800x600+800+0')
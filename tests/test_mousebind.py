@@ -121,6 +121,73 @@ def test_drag_move(hlwm, x11, mouse, repeat):
     assert (r.x, r.y) == (x + 12, y + 15)
 
 
+@pytest.mark.parametrize('frame_rate', [0, 5])
+def test_drag_move_frame_rate(hlwm, x11, mouse, frame_rate):
+    hlwm.call('set_attr tags.focus.floating on')
+    hlwm.attr.settings.drag_frame_rate = frame_rate
+    client, winid = x11.create_client()
+    x, y = x11.get_absolute_top_left(client)
+    mouse.move_into(winid, wait=True)
+
+    hlwm.call(['drag', winid, 'move'])
+    assert hlwm.attr.mouse.drag_motion_events() == 0
+    for _ in range(0, 4):
+        mouse.move_relative(3, 5)
+    mouse.click('1')  # stop dragging
+
+    # pending motions are applied when the drag ends
+    assert x11.get_absolute_top_left(client) == (x + 12, y + 20)
+    r = hlwm.attr.clients[winid].floating_geometry()
+    assert (r.x, r.y) == (x + 12, y + 20)
+    motions = hlwm.attr.mouse.drag_motion_events()
+    frames = hlwm.attr.mouse.drag_frames()
+    assert 1 <= frames <= motions
+    if frame_rate == 0:
+        assert frames == motions
+    assert hlwm.attr.mouse.drag_frame_usec_avg() <= hlwm.attr.mouse.drag_frame_usec_max()
+
+
+def test_drag_move_frame_rate_combines_motions(hlwm, x11, mouse):
+    hlwm.call('set_attr tags.focus.floating on')
+    hlwm.attr.settings.drag_frame_rate = 1
+    client, winid = x11.create_client()
+    x, y = x11.get_absolute_top_left(client)
+    mouse.move_into(winid, wait=True)
+
+    hlwm.call(['drag', winid, 'move'])
+    # no IPC call in between, so only the frame rate
+    # decides when a motion is applied
+    for _ in range(0, 20):
+        mouse.move_relative(1, 2, wait=False)
+    mouse.click('1')  # stop dragging
+
+    assert x11.get_absolute_top_left(client) == (x + 20, y + 40)
+    motions = hlwm.attr.mouse.drag_motion_events()
+    frames = hlwm.attr.mouse.drag_frames()
+    assert 1 <= frames < motions
+
+
+def test_drag_move_outline(hlwm, x11, mouse):
+    hlwm.attr.tags.focus.floating = 'on'
+    hlwm.attr.settings.drag_outline = True
+    client, winid = x11.create_client()
+    x, y = x11.get_absolute_top_left(client)
+    mouse.move_into(winid, wait=True)
+
+    hlwm.call(['drag', winid, 'move'])
+    mouse.move_relative(12, 15)
+    hlwm.call('true')  # sync
+
+    # during the drag, only the floating geometry is updated
+    r = hlwm.attr.clients[winid].floating_geometry()
+    assert (r.x, r.y) == (x + 12, y + 15)
+    assert x11.get_absolute_top_left(client) == (x, y)
+
+    mouse.click('1')  # stop dragging
+    hlwm.call('true')  # sync
+    assert x11.get_absolute_top_left(client) == (x + 12, y + 15)
+
+
 @pytest.mark.parametrize('update_dragged', [True, False])
 def test_drag_move_sends_configure(hlwm, x11, mouse, update_dragged):
     hlwm.attr.tags.focus.floating = 'on'
@@ -203,6 +270,26 @@ def test_drag_resize_tiled_client(hlwm, mouse, align):
     assert math.isclose(actual, expected, abs_tol=0.01)
 
 
+def test_drag_resize_tiled_client_outline(hlwm, x11, mouse):
+    hlwm.attr.settings.drag_outline = True
+    handle, winid = x11.create_client()
+    hlwm.call(['load', f'(split horizontal:0.5:1 (clients max:0) (clients max:0 {winid}))'])
+    geometry_before = x11.get_absolute_geometry(handle)
+    mouse.move_into(winid, x=10, y=30, wait=False)
+
+    hlwm.call(['drag', winid, 'resize'])
+    mouse.move_relative(200, 150)
+    hlwm.call('true')  # sync
+
+    # the fraction is already changed, but the client not yet
+    assert float(hlwm.attr.tags.focus.tiling.root.fraction()) > 0.6
+    assert x11.get_absolute_geometry(handle) == geometry_before
+
+    mouse.click('1')  # stop dragging
+    hlwm.call('true')  # sync
+    assert abs(x11.get_absolute_geometry(handle).x - (geometry_before.x + 200)) <= 2
+
+
 @pytest.mark.parametrize('dir1', ['left', 'right'])
 @pytest.mark.parametrize('dir2', ['top', 'bottom'])
 def test_drag_resize_tiled_client_in_two_directions(hlwm, mouse, dir1, dir2):
@@ -243,3 +243,25 @@ def test_panel_wm_strut_between_monitors_2x2_grid(hlwm, x11, edge):
         for m in [0, 1, 2, 3]:
             expected_pad = 30 if m in affected_monitors[edge] else 0
             assert int(hlwm.attr.monitors[m]['pad_' + edge]()) == expected_pad
+
+
+def test_panel_moves_to_other_monitor(hlwm, x11):
+    hlwm.call('add othertag')
+    hlwm.call('set_monitors 800x600+0+0 800x600+800+0')
+    winhandle, winid = x11.create_client(geometry=(0, 0, 800, 30),
+                                         window_type='_NET_WM_WINDOW_TYPE_DOCK')
+    assert hlwm.call('list_padding 0').stdout.strip() == '30 0 0 0'
+    assert hlwm.call('list_padding 1').stdout.strip() == '0 0 0 0'
+
+    # move the panel to the bottom of the other monitor
+    winhandle.configure(x=800, y=600 - 20, width=800, height=20)
+    x11.sync_with_hlwm()
+
+    assert hlwm.attr.panels[winid].geometry() == Rectangle(800, 580, 800, 20)
+    assert hlwm.call('list_padding 0').stdout.strip() == '0 0 0 0'
+    assert hlwm.call('list_padding 1').stdout.strip() == '0 0 20 0'
+
+    # removing the panel clears the pad
+    winhandle.destroy()
+    x11.sync_with_hlwm()
+    assert hlwm.call('list_padding 1').stdout.strip() == '0 0 0 0'
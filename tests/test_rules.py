@@ -1,4 +1,5 @@
 import pytest
+import time
 from herbstluftwm.types import Rectangle
 
 
@@ -866,6 +867,76 @@ def test_floatplacement_smart_create_many(hlwm, x11, invisible_tag):
         x11.create_client(geometry=index2geometry(i))
 
 
+def smart_placement_reference(rects, size, area, gap):
+    """a straightforward implementation of the smart placement:
+    try every candidate position and return the first one with the
+    least overlap to the given (floating) rectangles"""
+    width, height = size[0] + gap, size[1] + gap
+    rects = [(x, y, w + gap, h + gap) for (x, y, w, h) in rects]
+    x_values = {gap, area[0]}
+    y_values = {gap, area[1]}
+    for x, y, w, h in rects:
+        x_values |= {x, x + w}
+        y_values |= {y, y + h}
+    lefts = {v - d for v in x_values for d in [0, width]}
+    tops = {v - d for v in y_values for d in [0, height]}
+    best = None
+    for left in lefts:
+        if left < 0 or left + width > area[0]:
+            continue
+        for top in tops:
+            if top < 0 or top + height > area[1]:
+                continue
+            overlap = 0
+            for x, y, w, h in rects:
+                dx = min(left + width, x + w) - max(left, x)
+                dy = min(top + height, y + h) - max(top, y)
+                if dx > 0 and dy > 0:
+                    overlap += dx * dy
+            candidate = (overlap, left, top)
+            if best is None or candidate < best:
+                best = candidate
+    if best is None:
+        return (gap, gap)
+    return (best[1], best[2])
+
+
+@pytest.mark.exclude_from_coverage(
+    reason='This test is a benchmark of the placement algorithm')
+@pytest.mark.parametrize('count', [10, 50, 100, 200, 500])
+def test_floatplacement_smart_benchmark(hlwm, x11, count):
+    hlwm.call('move_monitor "" 1600x1200')
+    hlwm.call('set snap_gap 5')
+    hlwm.call('set window_border_width 0')
+    hlwm.call('rule floatplacement=smart floating=on')
+
+    # create many clients of pseudo-random sizes, but
+    # only wait for hlwm once in the end
+    handles = []
+    for i in range(0, count):
+        size = (40 + (i * 53) % 300, 30 + (i * 71) % 250)
+        handle, _ = x11.create_client(geometry=(0, 0) + size, sync_hlwm=False)
+        handles.append(handle)
+    x11.sync_with_hlwm()
+    rects = []
+    for handle in handles:
+        geo = x11.get_absolute_geometry(handle)
+        rects.append((geo.x, geo.y, geo.width, geo.height))
+
+    start = time.perf_counter()
+    handle, _ = x11.create_client(geometry=(0, 0, 200, 150))
+    duration = time.perf_counter() - start
+    print(f'placing a window next to {count} windows: {duration * 1000:.1f}ms')
+
+    geo = x11.get_absolute_geometry(handle)
+    assert 0 <= geo.x and geo.x + geo.width <= 1600
+    assert 0 <= geo.y and geo.y + geo.height <= 1200
+    if count <= 50:
+        # the reference implementation is too slow for more windows
+        expected = smart_placement_reference(rects, (200, 150), (1600, 1200), 5)
+        assert (geo.x, geo.y) == expected
+
+
 def test_floatplacement_smart_invisible_windows(hlwm):
     hlwm.call('add invisible')
     hlwm.call('rule floatplacement=smart floating=on tag=invisible')
@@ -363,3 +363,41 @@ def test_fullscreen_above_unmanaged(hlwm, x11, mouse, decorated):
     # double check that disabling fullscreen lowers the window again:
     hlwm.attr.clients[fs_winid].fullscreen = False
     assert x11.get_window_under_cursor() == um
+
+
+@pytest.mark.parametrize('raise_sequence', [
+    [0, 1, 2, 3, 4],
+    [4, 2, 0],
+    [1, 1, 3, 0, 3],
+])
+def test_x11_stacking_matches_stack_after_raise(hlwm, x11, raise_sequence):
+    hlwm.call('rule floating=on')
+    handles = [x11.create_client()[0] for _ in range(0, 5)]
+    winids = [x11.winid_str(h) for h in handles]
+    decorations = {x11.get_decoration_window(h).id: x11.winid_str(h)
+                   for h in handles}
+
+    for idx in raise_sequence:
+        hlwm.call(['raise', winids[idx]])
+        x11.sync_with_hlwm()
+
+        # the children of the root window are ordered from bottom to top
+        x11_stack = [decorations[w.id] for w in x11.root.query_tree().children
+                     if w.id in decorations]
+        x11_stack.reverse()
+        assert x11_stack == helper_get_stack_as_list(hlwm)
+
+
+def test_restack_count_only_increases_on_changes(hlwm):
+    hlwm.call('rule floating=on')
+    clients = hlwm.create_clients(3)
+    # the last client is on top
+    count = int(hlwm.attr.monitors.focus.restack_count())
+
+    hlwm.call(['raise', clients[2]])
+    hlwm.call(['jumpto', clients[2]])
+    assert int(hlwm.attr.monitors.focus.restack_count()) == count
+
+    hlwm.call(['raise', clients[0]])
+    assert int(hlwm.attr.monitors.focus.restack_count()) == count + 1
+    assert helper_get_stack_as_list(hlwm)[0] == clients[0]
@@ -169,6 +169,27 @@ def test_index_change(hlwm, tag_count, old_idx, new_idx):
         assert hlwm.get_attr(f'tags.{i}.name') == new_names[i]
 
 
+def test_remove_first_of_many_tags(hlwm):
+    names = ['tag' + str(i) for i in range(20)]
+    for n in names:
+        hlwm.call(['add', n])
+    hlwm.call('use tag0')
+
+    hlwm.call('merge_tag default')
+
+    assert hlwm.attr.tags.count() == len(names)
+    expected_children = [str(i) for i in range(len(names))]
+    expected_children += ['by-name', 'focus']
+    assert hlwm.list_children_via_attr('tags') == sorted(expected_children)
+    assert hlwm.list_children('tags.by-name') == sorted(names)
+    for i, n in enumerate(names):
+        assert hlwm.attr.tags[i].name() == n
+        assert hlwm.attr.tags[i].index() == i
+        assert hlwm.attr.tags['by-name'][n].index() == i
+    hlwm.call_xfail(['get_attr', 'tags.{}.name'.format(len(names))]) \
+        .expect_stderr('has no child named')
+
+
 @pytest.mark.parametrize("tag_count", [1, 4])
 def test_index_to_big(hlwm, tag_count):
     for i in range(1, tag_count):  # one tag already exists
@@ -400,6 +421,25 @@ def test_rename_multiple_tags(hlwm, hc_idle):
     ]
 
 
+def test_tag_lookup_after_rename_and_merge(hlwm):
+    hlwm.call('add foo')
+    hlwm.call('add bar')
+
+    hlwm.call('rename foo baz')
+    hlwm.call_xfail('use foo') \
+        .expect_stderr('no such tag: foo')
+    hlwm.call('use baz')
+    assert hlwm.attr.tags.focus.name() == 'baz'
+
+    # the old name is free again
+    hlwm.call('add foo')
+    hlwm.call('merge_tag bar foo')
+    hlwm.call_xfail('use bar') \
+        .expect_stderr('no such tag: bar')
+    hlwm.call('add bar')
+    assert hlwm.attr.tags['by-name'].bar.index() == 3
+
+
 # the test cases on focused_client are implicitly tests
 # for the DynChild_ related code.
 @pytest.mark.parametrize("client_exists", [True, False])